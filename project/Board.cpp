@@ -0,0 +1,151 @@
+#include "Board.h"
+
+unsigned long long Board_Pack(const state &s)
+{
+	unsigned long long pack = s.islt ? 1ull << BOARD_PACK_LT : 0;
+	for (int man = 0; man < 12; man++)
+	{
+		pack |= (unsigned long long)s.seat[man] << (man * 5);
+	}
+	return pack;
+}
+
+bool Board_Unpack(unsigned long long pack, state &s)
+{
+	//a seat out of the chessboard,two chessmen on one seat or bits over islt can't come from Board_Pack().
+	unsigned int used = 0;
+	if (pack >> (BOARD_PACK_LT + 1))
+	{
+		return false;
+	}
+	for (int man = 0; man < 12; man++)
+	{
+		int seat = (pack >> (man * 5)) & 31;
+		if (seat > BOARD_EATEN || (seat != BOARD_EATEN && (used & (1u << seat))))
+		{
+			return false;
+		}
+		used |= 1u << seat;
+	}
+	s.islt = (pack >> BOARD_PACK_LT) & 1;
+	s.key = s.islt ? BOARD_ZOBRIST.lt : 0;
+	s.alive[0] = 0;
+	s.alive[1] = 0;
+	s.live[0] = 0;
+	s.live[1] = 0;
+	for (int i = 0; i < BOARD_SIZE; i++)
+	{
+		for (int j = 0; j < BOARD_SIZE; j++)
+		{
+			s.cb.set[i][j] = 0;
+		}
+	}
+	for (int man = 0; man < 12; man++)
+	{
+		int seat = (pack >> (man * 5)) & 31;
+		s.seat[man] = char(seat);
+		if (seat != BOARD_EATEN)
+		{
+			int side = man / 6;
+			int number = man % 6 + 1;
+			s.cb.set[seat / BOARD_SIZE][seat % BOARD_SIZE] = side == 0 ? -number : number;
+			s.alive[side] |= 1 << (number - 1);
+			s.live[side]++;
+			s.key ^= BOARD_ZOBRIST.man[man][seat];
+		}
+	}
+	s.goal = s.cb.set[0][0] > 0 ? RB_SIGN : (s.cb.set[BOARD_SIZE - 1][BOARD_SIZE - 1] < 0 ? LT_SIGN : 0);
+	return true;
+}
+
+unsigned long long Board_MirrorPack(unsigned long long pack)
+{
+	unsigned long long mirror = pack & (1ull << BOARD_PACK_LT);
+	for (int man = 0; man < 12; man++)
+	{
+		mirror |= (unsigned long long)Board_MirrorSeat((pack >> (man * 5)) & 31) << (man * 5);
+	}
+	return mirror;
+}
+
+unsigned long long Board_RelabelPack(unsigned long long pack)
+{
+	unsigned long long relabel = pack & (1ull << BOARD_PACK_LT);
+	for (int side = 0; side < 2; side++)
+	{
+		int alive = 0;
+		for (int n = 1; n <= 6; n++)
+		{
+			if (((pack >> ((side * 6 + n - 1) * 5)) & 31) != BOARD_EATEN)
+			{
+				alive |= 1 << (n - 1);
+			}
+		}
+		for (int n = 1; n <= 6; n++)
+		{
+			int number = (alive & (1 << (n - 1))) ? BOARD_RELABEL.number[alive][n] : 0;
+			if (number == 0)
+			{
+				continue;
+			}
+			unsigned long long seat = (pack >> ((side * 6 + n - 1) * 5)) & 31;
+			relabel |= seat << ((side * 6 + number - 1) * 5);
+		}
+		//the numbers which nobody takes are eaten.
+		for (int n = 1; n <= 6; n++)
+		{
+			if (!(BOARD_RELABEL.canonical[alive] & (1 << (n - 1))))
+			{
+				relabel |= (unsigned long long)BOARD_EATEN << ((side * 6 + n - 1) * 5);
+			}
+		}
+	}
+	return relabel;
+}
+
+int Board_RelabelWay(const state &s, int W)
+{
+	int side = s.islt ? 0 : 1;
+	return (BOARD_RELABEL.number[s.alive[side]][W / 3 + 1] - 1) * 3 + W % 3;
+}
+
+int Board_UnrelabelWay(const state &s, int W)
+{
+	int side = s.islt ? 0 : 1;
+	return (BOARD_RELABEL.original[s.alive[side]][W / 3 + 1] - 1) * 3 + W % 3;
+}
+
+int Board_RelabelDice(const state &s, int dice)
+{
+	return BOARD_RELABEL.turned[s.alive[s.islt ? 0 : 1]] ? 7 - dice : dice;
+}
+
+unsigned long long Board_Canonical(const state &s, bool &mirrored)
+{
+	//Board_MirrorPack(Board_RelabelPack(Board_Pack(s))) in one pass,it is taken for every node of Expectimax.
+	//every chessman starts eaten,then the alive ones change their seat from BOARD_EATEN.
+	unsigned long long pack = s.islt ? 1ull << BOARD_PACK_LT : 0;
+	for (int man = 0; man < 12; man++)
+	{
+		pack |= (unsigned long long)BOARD_EATEN << (man * 5);
+	}
+	unsigned long long mirror = pack;
+	for (int side = 0; side < 2; side++)
+	{
+		int alive = s.alive[side];
+		for (int rest = alive; rest != 0; rest &= rest - 1)
+		{
+			int n = 1;
+			while (!(rest & (1 << (n - 1))))
+			{
+				n++;
+			}
+			int seat = s.seat[side * 6 + n - 1];
+			int shift = (side * 6 + BOARD_RELABEL.number[alive][n] - 1) * 5;
+			pack ^= (unsigned long long)(seat ^ BOARD_EATEN) << shift;
+			mirror ^= (unsigned long long)(Board_MirrorSeat(seat) ^ BOARD_EATEN) << shift;
+		}
+	}
+	mirrored = mirror < pack;
+	return mirrored ? mirror : pack;
+}
@@ -0,0 +1,577 @@
+#pragma once
+#include<assert.h>
+//rules core of the game,it don't include easyx or python,so it can be used out of Game.
+//the rules are templates on SIZE(a SIZE x SIZE chessboard) and PIECES(chessman of one side,and faces of the dice),
+//all tables are built when compiling.the game is BOARD_SIZE x BOARD_SIZE with BOARD_PIECES,
+//state,chessboard and the tables without _OF are that one,other sizes are for experiments with the same code.
+#define LT_SIGN -1
+#define RB_SIGN 1
+#define BOARD_SIZE 5
+#define BOARD_PIECES 6
+//packed state:5 bits of seat for every chessman(side * 6 + number - 1),and islt at bit 60,only for the game size.
+#define BOARD_PACK_LT 60
+//seat of a chessman which was eaten,also the target of a move out of chessboard,it is SIZE * SIZE in the templates.
+#define BOARD_EATEN (BOARD_SIZE * BOARD_SIZE)
+//lt wins on [SIZE - 1][SIZE - 1],rb wins on [0][0].
+#define BOARD_GOAL_LT (BOARD_EATEN - 1)
+#define BOARD_GOAL_RB 0
+template<int SIZE>
+struct basicchessboard
+{
+	int set[SIZE][SIZE];
+};
+//seat[side * PIECES + number - 1] is where the chessman is,so we don't need to look for it in cb.
+//bit (number - 1) of alive[side] is 1 when the chessman isn't eaten.
+//live[side] is how many chessman of the side aren't eaten.
+//goal is the sign of the side who is on its goal corner,0 when no one is.
+//key is the zobrist key of cb and islt,it is changed by every move.
+template<int SIZE, int PIECES>
+struct basicstate
+{
+	static_assert(SIZE >= 3 && SIZE <= 8 && PIECES >= 1 && PIECES <= 8, "seats must fit a char and numbers an alive mask");
+	basicchessboard<SIZE> cb;
+	bool islt;
+	char seat[2 * PIECES];
+	unsigned char alive[2];
+	char live[2];
+	char goal;
+	unsigned long long key;
+};
+typedef basicchessboard<BOARD_SIZE> chessboard;
+typedef basicstate<BOARD_SIZE, BOARD_PIECES> state;
+//zobrist key:xor of man[side * PIECES + number - 1][seat] for every chessman,and lt when islt.
+template<int SIZE, int PIECES>
+struct basiczobristtable
+{
+	unsigned long long man[2 * PIECES][SIZE * SIZE];
+	unsigned long long lt;
+};
+constexpr unsigned long long Board_SplitMix(unsigned long long &x)
+{
+	x += 0x9E3779B97F4A7C15ull;
+	unsigned long long z = x;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+template<int SIZE, int PIECES>
+constexpr basiczobristtable<SIZE, PIECES> Board_BuildZobristTable()
+{
+	basiczobristtable<SIZE, PIECES> m = {};
+	unsigned long long x = 20191011;
+	for (int man = 0; man < 2 * PIECES; man++)
+	{
+		for (int seat = 0; seat < SIZE * SIZE; seat++)
+		{
+			m.man[man][seat] = Board_SplitMix(x);
+		}
+	}
+	m.lt = Board_SplitMix(x);
+	return m;
+}
+template<int SIZE, int PIECES>
+constexpr basiczobristtable<SIZE, PIECES> BOARD_ZOBRIST_OF = Board_BuildZobristTable<SIZE, PIECES>();
+typedef basiczobristtable<BOARD_SIZE, BOARD_PIECES> zobristtable;
+static constexpr const zobristtable &BOARD_ZOBRIST = BOARD_ZOBRIST_OF<BOARD_SIZE, BOARD_PIECES>;
+//to[side][seat][W % 3] is the target seat,way 0:i - move,1:i - move and j - move,2:j - move.
+//lt goes to [SIZE - 1][SIZE - 1],rb goes to [0][0].seat SIZE * SIZE has no target,so eaten chessman need no check.
+template<int SIZE>
+struct basicmovetable
+{
+	char to[2][SIZE * SIZE + 1][3];
+};
+template<int SIZE>
+constexpr basicmovetable<SIZE> Board_BuildMoveTable()
+{
+	basicmovetable<SIZE> m = {};
+	for (int side = 0; side < 2; side++)
+	{
+		int move = side == 0 ? LT_SIGN : RB_SIGN;
+		for (int seat = 0; seat <= SIZE * SIZE; seat++)
+		{
+			for (int way = 0; way < 3; way++)
+			{
+				int i = seat / SIZE - (way != 2 ? move : 0);
+				int j = seat % SIZE - (way != 0 ? move : 0);
+				if (seat == SIZE * SIZE || i < 0 || i >= SIZE || j < 0 || j >= SIZE)
+				{
+					m.to[side][seat][way] = char(SIZE * SIZE);
+				}
+				else
+				{
+					m.to[side][seat][way] = char(i * SIZE + j);
+				}
+			}
+		}
+	}
+	return m;
+}
+template<int SIZE>
+constexpr basicmovetable<SIZE> BOARD_MOVE_OF = Board_BuildMoveTable<SIZE>();
+typedef basicmovetable<BOARD_SIZE> movetable;
+static constexpr const movetable &BOARD_MOVE = BOARD_MOVE_OF<BOARD_SIZE>;
+//which chessman can move by dice,it is the one of dice,or the nearest lower one and the nearest upper one.
+//man[0] is the dice one or the lower one,man[1] is the upper one,0 is none.
+//[l,r) is the limit of way that Expansion()/Simulation() give to FindMax.
+struct dicemove
+{
+	char man[2];
+	char l;
+	char r;
+};
+template<int PIECES>
+struct basicdicetable
+{
+	dicemove at[1 << PIECES][PIECES];
+};
+template<int PIECES>
+constexpr basicdicetable<PIECES> Board_BuildDiceTable()
+{
+	basicdicetable<PIECES> m = {};
+	for (int alive = 0; alive < (1 << PIECES); alive++)
+	{
+		for (int dice = 1; dice <= PIECES; dice++)
+		{
+			dicemove &d = m.at[alive][dice - 1];
+			if (alive & (1 << (dice - 1)))
+			{
+				d.man[0] = char(dice);
+				d.l = char((dice - 1) * 3);
+				d.r = char(dice * 3);
+				continue;
+			}
+			d.l = 0;
+			d.r = char(PIECES * 3);
+			for (int lower = dice - 1; lower >= 1; lower--)
+			{
+				if (alive & (1 << (lower - 1)))
+				{
+					d.man[0] = char(lower);
+					d.l = char((lower - 1) * 3);
+					break;
+				}
+			}
+			for (int upper = dice + 1; upper <= PIECES; upper++)
+			{
+				if (alive & (1 << (upper - 1)))
+				{
+					d.man[1] = char(upper);
+					d.r = char(upper * 3);
+					break;
+				}
+			}
+		}
+	}
+	return m;
+}
+template<int PIECES>
+constexpr basicdicetable<PIECES> BOARD_DICE_OF = Board_BuildDiceTable<PIECES>();
+typedef basicdicetable<BOARD_PIECES> dicetable;
+static constexpr const dicetable &BOARD_DICE = BOARD_DICE_OF<BOARD_PIECES>;
+//only for the game size.
+//only the dice rule looks at numbers,so the numbers of one side can be changed when every dice
+//still moves the chessman of the same rank(1 is the smallest alive one).
+//a side can also be turned round first,n to 7 - n:dice d then works like 7 - d did before,
+//and every dice is as likely,so the chance of winning stays the same.
+//canonical[alive] is the smallest alive which works like it,number[alive][n] is the new number of n,
+//original[alive][c] is the n whose new number is c,turned[alive] is true when it was turned round.
+//the ranks alone only change a side with one chessman left,turning round too takes 63 masks to 33.
+struct relabeltable
+{
+	unsigned char canonical[64];
+	char number[64][7];
+	char original[64][7];
+	bool turned[64];
+};
+constexpr int Board_Rank(int alive, int number)
+{
+	int rank = 0;
+	for (int n = 1; n <= number; n++)
+	{
+		if (alive & (1 << (n - 1)))
+		{
+			rank++;
+		}
+	}
+	return rank;
+}
+//the ranks which can move,whether it is the lower or the upper one doesn't matter.
+constexpr int Board_DiceRank(int alive, int dice)
+{
+	int rank = 0;
+	for (int k = 0; k < 2; k++)
+	{
+		if (BOARD_DICE.at[alive][dice].man[k] != 0)
+		{
+			rank |= 1 << Board_Rank(alive, BOARD_DICE.at[alive][dice].man[k]);
+		}
+	}
+	return rank;
+}
+constexpr bool Board_SameDiceRank(int a, int b)
+{
+	for (int dice = 0; dice < 6; dice++)
+	{
+		if (Board_DiceRank(a, dice) != Board_DiceRank(b, dice))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+constexpr int Board_Reverse(int alive)
+{
+	int reverse = 0;
+	for (int n = 1; n <= 6; n++)
+	{
+		if (alive & (1 << (n - 1)))
+		{
+			reverse |= 1 << (6 - n);
+		}
+	}
+	return reverse;
+}
+constexpr int Board_RankCanonical(int alive)
+{
+	for (int other = 0; other < alive; other++)
+	{
+		if (Board_Rank(other, 6) == Board_Rank(alive, 6) && Board_SameDiceRank(alive, other))
+		{
+			return other;
+		}
+	}
+	return alive;
+}
+constexpr relabeltable Board_BuildRelabelTable()
+{
+	relabeltable m = {};
+	for (int alive = 0; alive < 64; alive++)
+	{
+		int straight = Board_RankCanonical(alive);
+		int turned = Board_RankCanonical(Board_Reverse(alive));
+		int canonical = turned < straight ? turned : straight;
+		int from = turned < straight ? Board_Reverse(alive) : alive;
+		m.canonical[alive] = (unsigned char)canonical;
+		m.turned[alive] = turned < straight;
+		for (int n = 1; n <= 6; n++)
+		{
+			if (alive & (1 << (n - 1)))
+			{
+				int rank = Board_Rank(from, turned < straight ? 7 - n : n);
+				for (int c = 1; c <= 6; c++)
+				{
+					if ((canonical & (1 << (c - 1))) && Board_Rank(canonical, c) == rank)
+					{
+						m.number[alive][n] = char(c);
+						m.original[alive][c] = char(n);
+					}
+				}
+			}
+		}
+	}
+	return m;
+}
+constexpr relabeltable BOARD_RELABEL = Board_BuildRelabelTable();
+//legal ways for a dice,slot is the index in statestack:W % 3 for man[0],W % 3 + 3 for man[1].
+struct successor
+{
+	int count;
+	char way[6];
+	char slot[6];
+	int l;
+	int r;
+};
+//what Board_UnmakeMove() needs to take a move back,man and eaten are side * PIECES + number - 1,eaten is -1 when no one was eaten.
+struct undo
+{
+	char man;
+	char from;
+	char to;
+	char eaten;
+};
+//one state in one unsigned long long,for caches,dataset,book and saving tree.
+unsigned long long Board_Pack(const state &s);
+//false and s is not changed when pack isn't a state.
+bool Board_Unpack(unsigned long long pack, state &s);
+//the chessboard is the same after swapping i and j,goal corners don't move,way 0 and way 2 swap.
+constexpr int Board_MirrorSeat(int seat)
+{
+	return seat == BOARD_EATEN ? BOARD_EATEN : seat % BOARD_SIZE * BOARD_SIZE + seat / BOARD_SIZE;
+}
+constexpr int Board_MirrorWay(int W)
+{
+	return W - W % 3 + 2 - W % 3;
+}
+unsigned long long Board_MirrorPack(unsigned long long pack);
+//change the numbers of both sides by BOARD_RELABEL,and the way W of the side to move in s.
+unsigned long long Board_RelabelPack(unsigned long long pack);
+int Board_RelabelWay(const state &s, int W);
+//a relabeled way back to the numbers of s,and the dice which works the same after relabeling.
+int Board_UnrelabelWay(const state &s, int W);
+int Board_RelabelDice(const state &s, int dice);
+//relabel s,then take the smaller packed state of it and its mirror,one for every class.
+//a way W of s is Board_RelabelWay(s, W) in the canonical one,and then Board_MirrorWay() of it when mirrored is true,
+//the dice is Board_RelabelDice().
+unsigned long long Board_Canonical(const state &s, bool &mirrored);
+//the rules for any size,they are all inline templates,SIZE and PIECES come from the state.
+//key from the whole cb,only to check the key which was changed by moves.
+template<int SIZE, int PIECES>
+inline unsigned long long Board_Hash(const basicstate<SIZE, PIECES> &s)
+{
+	unsigned long long key = s.islt ? BOARD_ZOBRIST_OF<SIZE, PIECES>.lt : 0;
+	for (int i = 0; i < SIZE; i++)
+	{
+		for (int j = 0; j < SIZE; j++)
+		{
+			int c = s.cb.set[i][j];
+			if (c != 0)
+			{
+				int side = c < 0 ? 0 : 1;
+				key ^= BOARD_ZOBRIST_OF<SIZE, PIECES>.man[side * PIECES + (c < 0 ? -c : c) - 1][i * SIZE + j];
+			}
+		}
+	}
+	return key;
+}
+//the setup of Game::AutoNumberChessman(),other seats are 0,rb is lt turned round.
+//6 is the triangle of the game in the corner,other counts go 1 to PIECES along the diagonals from the corner,
+//the last diagonal must not touch the one of rb.
+constexpr int Board_AutoNumberDiagonals(int pieces)
+{
+	int d = 0;
+	while ((d + 1) * (d + 2) / 2 < pieces)
+	{
+		d++;
+	}
+	return d;
+}
+template<int SIZE, int PIECES>
+inline void Board_AutoNumber(basicchessboard<SIZE> &cb)
+{
+	static_assert(Board_AutoNumberDiagonals(PIECES) <= SIZE - 2, "the two corners would share seats");
+	const int triangle[6][3] = { { 0, 0, 6 }, { 0, 1, 1 }, { 0, 2, 3 }, { 1, 0, 2 }, { 1, 1, 5 }, { 2, 0, 4 } };
+	for (int i = 0; i < SIZE; i++)
+	{
+		for (int j = 0; j < SIZE; j++)
+		{
+			cb.set[i][j] = 0;
+		}
+	}
+	if (PIECES == 6)
+	{
+		for (int k = 0; k < 6; k++)
+		{
+			cb.set[triangle[k][0]][triangle[k][1]] = LT_SIGN * triangle[k][2];
+			cb.set[SIZE - 1 - triangle[k][0]][SIZE - 1 - triangle[k][1]] = RB_SIGN * triangle[k][2];
+		}
+		return;
+	}
+	int number = 1;
+	for (int d = 0; number <= PIECES; d++)
+	{
+		for (int i = 0; i <= d && number <= PIECES; i++, number++)
+		{
+			cb.set[i][d - i] = LT_SIGN * number;
+			cb.set[SIZE - 1 - i][SIZE - 1 - d + i] = RB_SIGN * number;
+		}
+	}
+}
+template<int SIZE>
+inline void Board_AutoNumber(basicchessboard<SIZE> &cb)
+{
+	Board_AutoNumber<SIZE, BOARD_PIECES>(cb);
+}
+//after cb or islt was changed by hand,seat,alive and key must be built again.
+template<int SIZE, int PIECES>
+inline void Board_Inital(basicstate<SIZE, PIECES> &s)
+{
+	s.alive[0] = 0;
+	s.alive[1] = 0;
+	s.live[0] = 0;
+	s.live[1] = 0;
+	for (int k = 0; k < 2 * PIECES; k++)
+	{
+		s.seat[k] = char(SIZE * SIZE);
+	}
+	for (int i = 0; i < SIZE; i++)
+	{
+		for (int j = 0; j < SIZE; j++)
+		{
+			int c = s.cb.set[i][j];
+			if (c != 0)
+			{
+				int side = c < 0 ? 0 : 1;
+				int number = c < 0 ? -c : c;
+				s.seat[side * PIECES + number - 1] = char(i * SIZE + j);
+				s.alive[side] |= 1 << (number - 1);
+				s.live[side]++;
+			}
+		}
+	}
+	s.goal = s.cb.set[0][0] > 0 ? RB_SIGN : (s.cb.set[SIZE - 1][SIZE - 1] < 0 ? LT_SIGN : 0);
+	s.key = Board_Hash(s);
+}
+//the rules for one side,SIDE is 0 for lt and 1 for rb,so offsets,tables and goal are known when compiling.
+//the caller must know who moves:SIDE is s.islt ? 0 : 1,for unmake it is the side who made the move.
+//Board_CanMove()/Board_MakeMove()/Board_UnmakeMove()/Board_Successor() choose SIDE at run time.
+template<int SIDE, int SIZE, int PIECES>
+inline bool Board_CanMoveSide(const basicstate<SIZE, PIECES> &s, int W)
+{
+	int f = s.seat[SIDE * PIECES + W / 3];
+	return BOARD_MOVE_OF<SIZE>.to[SIDE][f][W % 3] != SIZE * SIZE;
+}
+template<int SIDE, int SIZE, int PIECES>
+inline bool Board_MakeMoveSide(basicstate<SIZE, PIECES> &s, int W, undo &back)
+{
+	int man = SIDE * PIECES + W / 3;
+	int f = s.seat[man];
+	int t = BOARD_MOVE_OF<SIZE>.to[SIDE][f][W % 3];
+	back.man = char(man);
+	back.from = char(f);
+	back.to = char(t);
+	back.eaten = -1;
+	if (t == SIZE * SIZE)
+	{
+		return false;
+	}
+	//the chessman on target will be eaten,whatever side it is.
+	int eaten = s.cb.set[t / SIZE][t % SIZE];
+	if (eaten != 0)
+	{
+		int eaten_side = eaten < 0 ? 0 : 1;
+		int number = eaten < 0 ? -eaten : eaten;
+		int eaten_man = eaten_side * PIECES + number - 1;
+		back.eaten = char(eaten_man);
+		s.seat[eaten_man] = char(SIZE * SIZE);
+		s.alive[eaten_side] &= ~(1 << (number - 1));
+		s.live[eaten_side]--;
+		s.key ^= BOARD_ZOBRIST_OF<SIZE, PIECES>.man[eaten_man][t];
+	}
+	s.seat[man] = char(t);
+	if (t == (SIDE == 0 ? SIZE * SIZE - 1 : 0))
+	{
+		s.goal = char(SIDE == 0 ? LT_SIGN : RB_SIGN);
+	}
+	s.key ^= BOARD_ZOBRIST_OF<SIZE, PIECES>.man[man][f] ^ BOARD_ZOBRIST_OF<SIZE, PIECES>.man[man][t] ^ BOARD_ZOBRIST_OF<SIZE, PIECES>.lt;
+	s.cb.set[t / SIZE][t % SIZE] = s.cb.set[f / SIZE][f % SIZE];
+	s.cb.set[f / SIZE][f % SIZE] = 0;
+	s.islt = SIDE != 0;
+#ifdef _DEBUG
+	assert(s.key == Board_Hash(s));
+#endif
+	return true;
+}
+template<int SIDE, int SIZE, int PIECES>
+inline void Board_UnmakeMoveSide(basicstate<SIZE, PIECES> &s, const undo &back)
+{
+	int man = back.man;
+	int f = back.from;
+	int t = back.to;
+	s.islt = SIDE == 0;
+	s.cb.set[f / SIZE][f % SIZE] = s.cb.set[t / SIZE][t % SIZE];
+	s.cb.set[t / SIZE][t % SIZE] = 0;
+	s.key ^= BOARD_ZOBRIST_OF<SIZE, PIECES>.man[man][f] ^ BOARD_ZOBRIST_OF<SIZE, PIECES>.man[man][t] ^ BOARD_ZOBRIST_OF<SIZE, PIECES>.lt;
+	s.seat[man] = char(f);
+	if (t == (SIDE == 0 ? SIZE * SIZE - 1 : 0))
+	{
+		s.goal = 0;
+	}
+	if (back.eaten >= 0)
+	{
+		int eaten = back.eaten;
+		int eaten_side = eaten / PIECES;
+		int number = eaten % PIECES + 1;
+		s.cb.set[t / SIZE][t % SIZE] = eaten_side == 0 ? -number : number;
+		s.seat[eaten] = char(t);
+		s.alive[eaten_side] |= 1 << (number - 1);
+		s.live[eaten_side]++;
+		s.key ^= BOARD_ZOBRIST_OF<SIZE, PIECES>.man[eaten][t];
+	}
+#ifdef _DEBUG
+	assert(s.key == Board_Hash(s));
+#endif
+}
+template<int SIDE, int SIZE, int PIECES>
+inline void Board_SuccessorSide(const basicstate<SIZE, PIECES> &s, int dice, successor &next)
+{
+	const dicemove &d = BOARD_DICE_OF<PIECES>.at[s.alive[SIDE]][dice - 1];
+	next.count = 0;
+	next.l = d.l;
+	next.r = d.r;
+	for (int k = 0; k < 2; k++)
+	{
+		if (d.man[k] == 0)
+		{
+			continue;
+		}
+		int f = s.seat[SIDE * PIECES + d.man[k] - 1];
+		for (int way = 0; way < 3; way++)
+		{
+			if (BOARD_MOVE_OF<SIZE>.to[SIDE][f][way] != SIZE * SIZE)
+			{
+				next.way[next.count] = char((d.man[k] - 1) * 3 + way);
+				next.slot[next.count] = char(way + k * 3);
+				next.count++;
+			}
+		}
+	}
+}
+template<int SIZE, int PIECES>
+inline bool Board_CanMove(const basicstate<SIZE, PIECES> &s, int W)
+{
+	return s.islt ? Board_CanMoveSide<0>(s, W) : Board_CanMoveSide<1>(s, W);
+}
+//LT_SIGN or RB_SIGN for the winner,0 when the game isn't over,the same as the old Game::Judge().
+template<int SIZE, int PIECES>
+inline int Board_Judge(const basicstate<SIZE, PIECES> &s)
+{
+	if (s.goal != 0)
+	{
+		return s.goal;
+	}
+	if (s.live[0] == 0)
+	{
+		return RB_SIGN;
+	}
+	if (s.live[1] == 0)
+	{
+		return LT_SIGN;
+	}
+	return 0;
+}
+//move in place and take it back,so we don't need to copy the whole state for a trial move.
+template<int SIZE, int PIECES>
+inline bool Board_MakeMove(basicstate<SIZE, PIECES> &s, int W, undo &back)
+{
+	return s.islt ? Board_MakeMoveSide<0>(s, W, back) : Board_MakeMoveSide<1>(s, W, back);
+}
+template<int SIZE, int PIECES>
+inline void Board_UnmakeMove(basicstate<SIZE, PIECES> &s, const undo &back)
+{
+	if (back.man < PIECES)
+	{
+		Board_UnmakeMoveSide<0>(s, back);
+	}
+	else
+	{
+		Board_UnmakeMoveSide<1>(s, back);
+	}
+}
+template<int SIZE, int PIECES>
+inline bool Board_MoveChessman(basicstate<SIZE, PIECES> &s, int W)
+{
+	undo back;
+	return Board_MakeMove(s, W, back);
+}
+template<int SIZE, int PIECES>
+inline void Board_Successor(const basicstate<SIZE, PIECES> &s, int dice, successor &next)
+{
+	if (s.islt)
+	{
+		Board_SuccessorSide<0>(s, dice, next);
+	}
+	else
+	{
+		Board_SuccessorSide<1>(s, dice, next);
+	}
+}
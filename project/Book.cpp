@@ -0,0 +1,155 @@
+#include "Book.h"
+#include<algorithm>
+#include<cstring>
+#include<fstream>
+#include<thread>
+
+static bool Book_Less(const bookentry &a, const bookentry &b)
+{
+	return a.pack != b.pack ? a.pack < b.pack : a.dice < b.dice;
+}
+
+Book::Book()
+{
+	count = 0;
+	time = 0;
+	entry = NULL;
+}
+
+Book::~Book()
+{
+}
+
+void Book::Build_Part(const vector<state> &position, const Tablebase *table, int thread, int thread_count)
+{
+	Expectimax search;
+	search.SetTablebase(table);
+	for (size_t k = thread; k < position.size(); k += thread_count)
+	{
+		for (int dice = 1; dice <= 6; dice++)
+		{
+			bookentry &e = built[k * 6 + dice - 1];
+			e.pack = Board_Pack(position[k]);
+			e.dice = char(dice);
+			e.way = char(search.Search(position[k], dice, time));
+			e.depth = char(search.Depth());
+			e.reserve = 0;
+			e.value = search.Value();
+			e.nodes = search.Nodes();
+		}
+	}
+}
+
+void Book::Build(const vector<state> &position, const Tablebase *table, int time_ms, int thread_count)
+{
+	if (thread_count < 1)
+	{
+		thread_count = 1;
+	}
+	file.Close();
+	time = time_ms;
+	built.assign(position.size() * 6, bookentry());
+	vector<std::thread> worker;
+	for (int t = 1; t < thread_count; t++)
+	{
+		worker.push_back(std::thread(&Book::Build_Part, this, std::cref(position), table, t, thread_count));
+	}
+	Build_Part(position, table, 0, thread_count);
+	for (size_t t = 0; t < worker.size(); t++)
+	{
+		worker[t].join();
+	}
+	//the same state may be given twice,keep one.
+	std::sort(built.begin(), built.end(), Book_Less);
+	size_t last = 0;
+	for (size_t k = 1; k < built.size(); k++)
+	{
+		if (Book_Less(built[last], built[k]))
+		{
+			built[++last] = built[k];
+		}
+	}
+	built.resize(built.empty() ? 0 : last + 1);
+	count = int(built.size());
+	entry = built.data();
+}
+
+bool Book::Save(const char *path)
+{
+	std::ofstream out(path, std::ios::binary);
+	if (!out.is_open())
+	{
+		return false;
+	}
+	bookheader header = {};
+	strcpy(header.magic, BOOK_MAGIC);
+	header.count = count;
+	header.time = time;
+	out.write((const char *)&header, sizeof(header));
+	out.write((const char *)entry, sizeof(bookentry) * count);
+	return out.good();
+}
+
+bool Book::Open(const char *path)
+{
+	entry = NULL;
+	count = 0;
+	built.clear();
+	if (!file.Open(path) || file.Size() < (long long)sizeof(bookheader))
+	{
+		file.Close();
+		return false;
+	}
+	const bookheader *header = (const bookheader *)file.Data();
+	if (strncmp(header->magic, BOOK_MAGIC, 8) != 0 || header->count < 0 || file.Size() < (long long)(sizeof(bookheader) + sizeof(bookentry) * header->count))
+	{
+		file.Close();
+		return false;
+	}
+	count = header->count;
+	time = header->time;
+	entry = (const bookentry *)(file.Data() + sizeof(bookheader));
+	return true;
+}
+
+int Book::Count() const
+{
+	return count;
+}
+
+const bookentry *Book::Find(const state &s, int dice) const
+{
+	if (count == 0)
+	{
+		return NULL;
+	}
+	bookentry key = {};
+	key.pack = Board_Pack(s);
+	key.dice = char(dice);
+	const bookentry *e = std::lower_bound(entry, entry + count, key, Book_Less);
+	if (e == entry + count || e->pack != key.pack || e->dice != key.dice)
+	{
+		return NULL;
+	}
+	return e;
+}
+
+bool Book::Probe(const state &s, int dice, int &way) const
+{
+	const bookentry *e = Find(s, dice);
+	if (e == NULL)
+	{
+		return false;
+	}
+	successor next;
+	Board_Successor(s, dice, next);
+	for (int k = 0; k < next.count; k++)
+	{
+		if (next.way[k] == e->way)
+		{
+			way = e->way;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include"Board.h"
+#include"Expectimax.h"
+#include"MappedFile.h"
+#include<vector>
+using std::vector;
+//opening book:the best way for a state and dice,found by a long Expectimax search offline.
+//the setups repeat every game,so the first moves of ai can be read instead of searched.
+//file:bookheader,then count bookentry sorted by pack and dice,Probe() does a binary search in the mapped file.
+#define BOOK_FILE "book.bin"
+#define BOOK_MAGIC "WTNBK01"
+struct bookheader
+{
+	char magic[8];
+	int count;
+	int time;//ms of every search
+};
+struct bookentry
+{
+	unsigned long long pack;//Board_Pack()
+	char dice;
+	char way;
+	char depth;//the deepest search that was done
+	char reserve;
+	float value;//chance of winning for the side to move
+	long long nodes;
+};
+class Book
+{
+public:
+	Book();
+	~Book();
+	//search every state with all 6 dice for time_ms,each thread takes every thread_count-th state.
+	void Build(const vector<state> &position, const Tablebase *table, int time_ms, int thread_count);
+	bool Save(const char *path);
+	//map a file made by Save(),false when it is missing or broken.
+	bool Open(const char *path);
+	int Count() const;
+	//NULL when the book doesn't have s with dice.
+	const bookentry *Find(const state &s, int dice) const;
+	//false when the book doesn't have s with dice,or its way can't be played.
+	bool Probe(const state &s, int dice, int &way) const;
+private:
+	int count;
+	int time;
+	vector<bookentry> built;
+	const bookentry *entry;
+	MappedFile file;
+
+	void Build_Part(const vector<state> &position, const Tablebase *table, int thread, int thread_count);
+};
@@ -0,0 +1,19 @@
+#include "Evaluate.h"
+
+float Evaluate_LtWin(const state &s)
+{
+	const float (*lt)[26] = EVALUATE_TABLE.turns[0][s.alive[0]];
+	const float (*rb)[26] = EVALUATE_TABLE.turns[1][s.alive[1]];
+	float lt_turns = EVALUATE_FAR;
+	float rb_turns = EVALUATE_FAR;
+	for (int n = 0; n < 6; n++)
+	{
+		float t = lt[n][int(s.seat[n])];
+		lt_turns = t < lt_turns ? t : lt_turns;
+		t = rb[n][int(s.seat[n + 6])];
+		rb_turns = t < rb_turns ? t : rb_turns;
+	}
+	float x = EVALUATE_TEMPO * (rb_turns - lt_turns) + EVALUATE_MATERIAL * (s.live[0] - s.live[1]) + (s.islt ? EVALUATE_MOVE : -EVALUATE_MOVE);
+	//a sigmoid without exp().
+	return 0.5f + 0.5f * x / (1 + (x < 0 ? -x : x));
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include"Board.h"
+//static value of a state without playing it,for the end of a short playout or the prior of a new node.
+//a chessman needs about dist / chance of its own turns to get the goal alone,dist is the steps to the goal corner
+//(a diagonal move is one step) and chance is how many dice of 6 move it with the alive ones of its side.
+//the side whose best chessman needs fewer turns is ahead,more chessman and being to move are worth a little.
+//the weights are fitted by logistic regression on the ends of random games.
+#define EVALUATE_TEMPO 0.103f
+#define EVALUATE_MATERIAL 0.030f
+#define EVALUATE_MOVE 0.074f
+#define EVALUATE_FAR 99.0f//turns of an eaten chessman
+//turns[side][alive][n][seat],seat BOARD_EATEN gives EVALUATE_FAR so no test is needed.
+struct evaluatetable
+{
+	float turns[2][64][6][26];
+};
+constexpr evaluatetable Evaluate_BuildTable()
+{
+	evaluatetable m = {};
+	for (int side = 0; side < 2; side++)
+	{
+		for (int alive = 0; alive < 64; alive++)
+		{
+			for (int n = 0; n < 6; n++)
+			{
+				int chance = 0;
+				for (int dice = 0; dice < 6; dice++)
+				{
+					if (BOARD_DICE.at[alive][dice].man[0] == n + 1 || BOARD_DICE.at[alive][dice].man[1] == n + 1)
+					{
+						chance++;
+					}
+				}
+				for (int seat = 0; seat < 26; seat++)
+				{
+					int i = side == 0 ? 4 - seat / 5 : seat / 5;
+					int j = side == 0 ? 4 - seat % 5 : seat % 5;
+					int dist = i > j ? i : j;
+					m.turns[side][alive][n][seat] = seat == BOARD_EATEN || chance == 0 ? EVALUATE_FAR : dist * 6.0f / chance;
+				}
+			}
+		}
+	}
+	return m;
+}
+constexpr evaluatetable EVALUATE_TABLE = Evaluate_BuildTable();
+//chance of lt winning.
+float Evaluate_LtWin(const state &s);
@@ -0,0 +1,302 @@
+#include "Expectimax.h"
+
+float Expectimax_Evaluate(const state &s)
+{
+	float lt_win = Evaluate_LtWin(s);
+	return s.islt ? lt_win : 1 - lt_win;
+}
+
+Expectimax::Expectimax()
+{
+	tt.resize(size_t(1) << EXPECTIMAX_TT_BITS);
+	for (size_t k = 0; k < tt.size(); k++)
+	{
+		tt[k].key = 0;
+		tt[k].depth = -1;
+	}
+	table = NULL;
+	stop = false;
+	nodes = 0;
+	checks = 0;
+	finished_depth = 0;
+	finished_value = 0.5f;
+}
+
+Expectimax::~Expectimax()
+{
+}
+
+void Expectimax::SetTablebase(const Tablebase *table)
+{
+	this->table = table;
+}
+
+long long Expectimax::Nodes() const
+{
+	return nodes;
+}
+
+int Expectimax::Depth() const
+{
+	return finished_depth;
+}
+
+float Expectimax::Value() const
+{
+	return finished_value;
+}
+
+bool Expectimax::TimeOut()
+{
+	if (!stop && (++checks & 1023) == 0 && std::chrono::steady_clock::now() >= deadline)
+	{
+		stop = true;
+	}
+	return stop;
+}
+
+ttentry &Expectimax::Entry(const ttkey &k)
+{
+	//the low bits of a pack are only the seat of lt 1,mix all of them into the index.
+	return tt[(k.pack * 0x9E3779B97F4A7C15ull) >> (64 - EXPECTIMAX_TT_BITS)];
+}
+
+int Expectimax::Best(const state &s, const ttkey &k, int dice)
+{
+	const ttentry &e = Entry(k);
+	int best = e.key == k.pack ? e.best[Board_RelabelDice(s, dice) - 1] : -1;
+	if (best < 0)
+	{
+		return -1;
+	}
+	return Board_UnrelabelWay(s, k.mirrored ? Board_MirrorWay(best) : best);
+}
+
+void Expectimax::SetBest(const state &s, const ttkey &k, int dice, int best)
+{
+	ttentry &e = Entry(k);
+	if (e.key != k.pack)
+	{
+		e.key = k.pack;
+		e.depth = -1;
+		for (int d = 0; d < 6; d++)
+		{
+			e.best[d] = -1;
+		}
+	}
+	best = Board_RelabelWay(s, best);
+	e.best[Board_RelabelDice(s, dice) - 1] = char(k.mirrored ? Board_MirrorWay(best) : best);
+}
+
+//best of the last search first,then reaching the goal,eating the other side,going diagonal,eating own chessman last.
+int Expectimax::Order(const state &s, const successor &next, int tt_best, char *order)
+{
+	int side = s.islt ? 0 : 1;
+	int score[6];
+	for (int k = 0; k < next.count; k++)
+	{
+		int W = next.way[k];
+		int t = BOARD_MOVE.to[side][int(s.seat[side * BOARD_PIECES + W / 3])][W % 3];
+		int eaten = s.cb.set[t / BOARD_SIZE][t % BOARD_SIZE];
+		score[k] = 0;
+		if (W == tt_best)
+		{
+			score[k] += 10000;
+		}
+		if (t == (side == 0 ? BOARD_GOAL_LT : BOARD_GOAL_RB))
+		{
+			score[k] += 1000;
+		}
+		if (eaten != 0)
+		{
+			score[k] += (eaten < 0) == (side == 0) ? -100 : 100;
+		}
+		if (W % 3 == 1)
+		{
+			score[k] += 10;
+		}
+		order[k] = char(W);
+		for (int j = k; j > 0 && score[j] > score[j - 1]; j--)
+		{
+			int tem = score[j];
+			score[j] = score[j - 1];
+			score[j - 1] = tem;
+			char way = order[j];
+			order[j] = order[j - 1];
+			order[j - 1] = way;
+		}
+	}
+	return next.count;
+}
+
+float Expectimax::Max(state &s, const ttkey &k, int dice, int depth, float alpha, float beta, int &best)
+{
+	successor next;
+	char order[6];
+	undo back;
+	Board_Successor(s, dice, next);
+	int count = Order(s, next, Best(s, k, dice), order);
+	float best_value = -1;
+	best = order[0];
+	for (int k = 0; k < count; k++)
+	{
+		Board_MakeMove(s, order[k], back);
+		float value = 1 - Chance(s, depth - 1, 1 - beta, 1 - (alpha > best_value ? alpha : best_value));
+		Board_UnmakeMove(s, back);
+		if (stop)
+		{
+			return 0;
+		}
+		if (value > best_value)
+		{
+			best_value = value;
+			best = order[k];
+			if (value >= beta)
+			{
+				break;
+			}
+		}
+	}
+	SetBest(s, k, dice, best);
+	return best_value;
+}
+
+//Star2 probe:only the first move for the dice,it is a lower bound of Max().
+float Expectimax::Probe(state &s, const ttkey &k, int dice, int depth, float alpha, float beta)
+{
+	successor next;
+	char order[6];
+	undo back;
+	Board_Successor(s, dice, next);
+	Order(s, next, Best(s, k, dice), order);
+	Board_MakeMove(s, order[0], back);
+	float value = 1 - Chance(s, depth - 1, 1 - beta, 1 - alpha);
+	Board_UnmakeMove(s, back);
+	return value;
+}
+
+float Expectimax::Chance(state &s, int depth, float alpha, float beta)
+{
+	nodes++;
+	int result = Board_Judge(s);
+	if (result != 0)
+	{
+		return (result == LT_SIGN) == s.islt ? 1.0f : 0.0f;
+	}
+	float lt_win;
+	if (table != NULL && table->Probe(s, lt_win))
+	{
+		return s.islt ? lt_win : 1 - lt_win;
+	}
+	if (depth <= 0)
+	{
+		return Expectimax_Evaluate(s);
+	}
+	if (TimeOut())
+	{
+		return 0;
+	}
+	ttkey k;
+	k.pack = Board_Canonical(s, k.mirrored);
+	ttentry &e = Entry(k);
+	if (e.key == k.pack && e.depth >= depth)
+	{
+		if (e.bound == EXPECTIMAX_EXACT || (e.bound == EXPECTIMAX_LOWER && e.value >= beta) || (e.bound == EXPECTIMAX_UPPER && e.value <= alpha))
+		{
+			return e.value;
+		}
+	}
+	//Star2:a lower bound for every dice from its first move,maybe it is enough to cut.
+	float lower[6];
+	float lower_sum = 0;
+	for (int d = 0; d < 6; d++)
+	{
+		float b = 6 * beta - lower_sum;
+		lower[d] = Probe(s, k, d + 1, depth, 0, b < 1 ? b : 1);
+		if (stop)
+		{
+			return 0;
+		}
+		lower_sum += lower[d];
+		if (lower_sum >= 6 * beta)
+		{
+			return lower_sum / 6;
+		}
+	}
+	//Star1:the dice left are between their lower bound and 1.
+	float sum = 0;
+	int bound = EXPECTIMAX_EXACT;
+	float value = 0;
+	for (int d = 0; d < 6; d++)
+	{
+		lower_sum -= lower[d];
+		float a = 6 * alpha - sum - (5 - d);
+		float b = 6 * beta - sum - lower_sum;
+		int best;
+		float v = Max(s, k, d + 1, depth, a > 0 ? a : 0, b < 1 ? b : 1, best);
+		if (stop)
+		{
+			return 0;
+		}
+		if (v <= a)
+		{
+			value = (sum + v + (5 - d)) / 6;
+			bound = EXPECTIMAX_UPPER;
+			break;
+		}
+		if (v >= b)
+		{
+			value = (sum + v + lower_sum) / 6;
+			bound = EXPECTIMAX_LOWER;
+			break;
+		}
+		sum += v;
+		value = sum / 6;
+	}
+	ttentry &save = Entry(k);
+	if (save.key != k.pack)
+	{
+		save.key = k.pack;
+		for (int d = 0; d < 6; d++)
+		{
+			save.best[d] = -1;
+		}
+	}
+	save.depth = char(depth);
+	save.bound = char(bound);
+	save.value = value;
+	return value;
+}
+
+int Expectimax::Search(const state &s, int dice, int time_ms)
+{
+	state root = s;
+	successor next;
+	Board_Successor(root, dice, next);
+	deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(time_ms);
+	stop = false;
+	nodes = 0;
+	checks = 0;
+	finished_depth = 0;
+	finished_value = 0.5f;
+	int best_way = next.way[0];
+	if (next.count == 1)
+	{
+		return best_way;
+	}
+	ttkey k;
+	k.pack = Board_Canonical(root, k.mirrored);
+	for (int depth = 1; depth <= EXPECTIMAX_MAX_DEPTH; depth++)
+	{
+		int way;
+		float value = Max(root, k, dice, depth, 0, 1, way);
+		if (stop)
+		{
+			break;
+		}
+		best_way = way;
+		finished_depth = depth;
+		finished_value = value;
+	}
+	return best_way;
+}
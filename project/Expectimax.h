@@ -0,0 +1,64 @@
+#pragma once
+#include"Board.h"
+#include"Tablebase.h"
+#include"Evaluate.h"
+#include<chrono>
+#include<vector>
+using std::vector;
+//the other ai:iterative deepening expectiminimax,dice are chance nodes,Star1/Star2 cut them.
+//a value is the chance that the side to move wins,so it is in [0,1] and the other side sees 1 - value.
+//depth counts chance nodes,at depth 0 it uses Expectimax_Evaluate() or the tablebase.
+#define EXPECTIMAX_TT_BITS 20
+#define EXPECTIMAX_MAX_DEPTH 64
+#define EXPECTIMAX_EXACT 0
+#define EXPECTIMAX_LOWER 1
+#define EXPECTIMAX_UPPER 2
+//one chance node,best[dice - 1] is the way which was best for the dice,-1 when unknown.
+//key is Board_Canonical() of the state,so a state shares its entry with the relabeled and mirrored ones,
+//dice and ways in best[] are the ones of the canonical state.
+struct ttentry
+{
+	unsigned long long key;
+	float value;
+	char depth;
+	char bound;
+	char best[6];
+};
+struct ttkey
+{
+	unsigned long long pack;
+	bool mirrored;
+};
+//Evaluate_LtWin() for the side to move.
+float Expectimax_Evaluate(const state &s);
+class Expectimax
+{
+public:
+	Expectimax();
+	~Expectimax();
+	//tablebase values are used when table isn't NULL and knows the state.
+	void SetTablebase(const Tablebase *table);
+	//best way for s with dice,deeper and deeper until time_ms is over.
+	int Search(const state &s, int dice, int time_ms);
+	long long Nodes() const;
+	int Depth() const;
+	float Value() const;
+private:
+	vector<ttentry> tt;
+	const Tablebase *table;
+	std::chrono::steady_clock::time_point deadline;
+	bool stop;
+	long long nodes;
+	long long checks;//calls of TimeOut(),the clock is read every 1024 of them
+	int finished_depth;
+	float finished_value;
+
+	bool TimeOut();
+	ttentry &Entry(const ttkey &k);
+	int Best(const state &s, const ttkey &k, int dice);
+	void SetBest(const state &s, const ttkey &k, int dice, int best);
+	int Order(const state &s, const successor &next, int tt_best, char *order);
+	float Chance(state &s, int depth, float alpha, float beta);
+	float Probe(state &s, const ttkey &k, int dice, int depth, float alpha, float beta);
+	float Max(state &s, const ttkey &k, int dice, int depth, float alpha, float beta, int &best);
+};
@@ -1,4 +1,5 @@
 #include "Game.h"
+#include<chrono>
 
 
 
@@ -7,6 +8,12 @@ Game::Game()
 	//randomDiceList = new RandomList(1, 7);
 	int tem_dice;
 	InitalNeuralNetwork();
+	//without the file,the game plays all playouts to the end.
+	table.Open(TABLEBASE_FILE);
+	search.SetTablebase(&table);
+	//without the file,ai uses the setup of Board_AutoNumber().
+	setup.Open(SETUP_FILE);
+	book.Open(BOOK_FILE);
 	N_Inital();
 	if (draw.GetMode() == 'A')
 	{
@@ -31,6 +38,7 @@ Game::Game()
 		lt_is_first = false;
 	}
 	//need a chosen to choose how to number chessman
+	Board_Inital(now);
 	the_line_of_time.push_back(now);
 	do
 	{
@@ -41,9 +49,18 @@ Game::Game()
 			Record_now = now;
 			Dice = draw.GetDice();
 			tem_dice = Dice;
-			Expansion();
-			Simulation();
-			Way = tree.N_FindMax(limit_l, limit_r);
+			//a book hit needs no search.
+			if (!book.Probe(now, Dice, Way))
+			{
+#if AI_ENGINE == ENGINE_EXPECTIMAX
+				Way = search.Search(now, Dice, EXPECTIMAX_TIME);
+#else
+				Expansion();
+				Simulation();
+				Way = tree.N_FindMax(limit_l, limit_r);
+#endif
+			}
+			tree.N_SetImitation(Way);
 			N_MoveChessman(Way);//ensure islt being not
 			tree.N_Move(Way);
 			draw.PaintChessboard();
@@ -65,6 +82,9 @@ Game::Game()
 			{
 				tree.N_SetImitation(Way);
 				tree.N_Move(Way);
+#if TREE_COMPACT
+				tree.Compact();
+#endif
 			}
 			draw.PaintChessboard();
 			draw.PaintChessman(now.cb);
@@ -122,70 +142,24 @@ Game::~Game()
 void Game::Record_Dataset(int tem_dice, int tem_way, state tem)
 {
 	statestack *tem_state = new statestack;
-	int start, end;
-	bool finded_l, finded_r;
-	finded_l = false;
-	finded_r = false;
-	for (int t = 0; !(finded_l && finded_r); t += 1)
+	successor next;
+	undo back;
+	Board_Successor(tem, tem_dice, next);
+	for (int i = 0; i < 6; i++)
 	{
-		if (!finded_l)
-		{
-			start = ((tem_dice - 1 - t) * 3);
-		}
-		if (!finded_r)
-		{
-			end = ((tem_dice + t) * 3);
-		}
-		if (start < 0)
-		{
-			start = 0;
-			finded_l = true;
-		}
-		if (end > 18)
+		tem_state->cb[i] = zero;
+	}
+	for (int k = 0; k < next.count; k++)
+	{
+		if (Board_MakeMove(tem, next.way[k], back))
 		{
-			end = 18;
-			finded_r = true;
+			//can move,will create new seat to storage;
+			tem_state->cb[int(next.slot[k])] = tem.cb;
+			Board_UnmakeMove(tem, back);
 		}
-		//ҪмI_CanMove޳
-		for (int i = 0; i < 6; i++)
+		else
 		{
-			tem_state->cb[i] = zero;
-		}
-		for (int j = start; j < end; j++) 
-		{
-			imitation = tem;
-			if (I_CanMove(j))
-			{
-				if (I_MoveChessman(j))
-				{
-					//can move,will create new seat to storage;
-					if (t == 0)
-					{
-						tem_state->cb[j % 3] = imitation.cb;
-						finded_l = true;
-						finded_r = true;
-					}
-					else
-					{
-						if (j < start + 3)
-						{
-							//0-3
-							tem_state->cb[j % 3] = imitation.cb;
-							finded_l = true;
-						}
-						if (j >= end - 3)
-						{
-							//3-6
-							tem_state->cb[(j % 3) + 3] = imitation.cb;
-							finded_r = true;
-						}
-					}
-				}
-				else
-				{
-					InputBox(NULL, NULL, "debug in 406");
-				}
-			}
+			InputBox(NULL, NULL, "debug in 406");
 		}
 	}
 	if ((tem_way - (tem_way % 3)) / 3 == tem_dice - 1)
@@ -220,9 +194,9 @@ void Game::Record_PrintDataset()
 		data.flush();
 		for (int j = 0; j < 6; j++)
 		{
-			for (int y = 0; y < 5; y++)
+			for (int y = 0; y < BOARD_SIZE; y++)
 			{
-				for (int x = 0; x < 5; x++)
+				for (int x = 0; x < BOARD_SIZE; x++)
 				{
 					data<<dataset[i]->cb[j].set[x][y]<<" ";
 					data.flush();
@@ -235,9 +209,9 @@ void Game::Record_PrintDataset()
 
 void Game::N_Inital()
 {
-	for (int i = 0; i < 5; i++)
+	for (int i = 0; i < BOARD_SIZE; i++)
 	{
-		for (int j = 0; j < 5; j++)
+		for (int j = 0; j < BOARD_SIZE; j++)
 		{
 			now.cb.set[i][j] = 0;
 			zero.set[i][j] = 0;
@@ -255,35 +229,28 @@ void Game::stack_Inital()
 
 void Game::AutoNumberChessman()
 {
-	now.cb.set[0][0] = -6;
-	now.cb.set[0][1] = -1;
-	now.cb.set[0][2] = -3;
-	now.cb.set[1][0] = -2;
-	now.cb.set[1][1] = -5;
-	now.cb.set[2][0] = -4;
-	now.cb.set[2][4] = 4;
-	now.cb.set[3][3] = 5;
-	now.cb.set[3][4] = 2;
-	now.cb.set[4][2] = 3;
-	now.cb.set[4][3] = 1;
-	now.cb.set[4][4] = 6;
+	Board_AutoNumber(now.cb);
+	setup.Place(now.cb, 0);
 }
 
 void Game::ManualNumberChessman()
 {
-	now.cb.set[0][0] = -6;
-	now.cb.set[0][1] = -1;
-	now.cb.set[0][2] = -3;
-	now.cb.set[1][0] = -2;
-	now.cb.set[1][1] = -5;
-	now.cb.set[2][0] = -4;
+	if (!setup.Place(now.cb, 0))
+	{
+		now.cb.set[0][0] = -6;
+		now.cb.set[0][1] = -1;
+		now.cb.set[0][2] = -3;
+		now.cb.set[1][0] = -2;
+		now.cb.set[1][1] = -5;
+		now.cb.set[2][0] = -4;
+	}
 	draw.PaintChessboard();
-	for (int i = 2; i < 5; i++)
+	for (int i = BOARD_SIZE - 3; i < BOARD_SIZE; i++)
 	{
-		for (int j = 2; j < 5; j++)
+		for (int j = BOARD_SIZE - 3; j < BOARD_SIZE; j++)
 		{
 			now.cb.set[i][j] = 0;
-			if (i >= 2 && j >= 2 && i + j >= 6)
+			if (i + j >= 2 * BOARD_SIZE - 4)
 			{
 
 				now.cb.set[i][j] = draw.NumberChessman(i, j);
@@ -305,261 +272,48 @@ int Game::transform_W_D(int W)
 
 bool Game::N_CanMove(int W)
 {
-	int move;
-	if (now.islt)
-	{
-		move = LT_SIGN;
-	}
-	else
-	{
-		move = RB_SIGN;
-	}
-	for (int i = 0; i < 5; i++)
-	{
-		for (int j = 0; j < 5; j++)
-		{
-			if (now.cb.set[i][j] == transform_W_D(W)*move)
-			{
-				switch (W % 3)
-				{
-				case 0:
-					if (i - move <= 4 && i - move >= 0)
-					{
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-					break;
-				case 1:
-					if (i - move <= 4 && i - move >= 0 && j - move <= 4 && j - move >= 0)
-					{
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-					break;
-				case 2:
-					if (j - move <= 4 && j - move >= 0)
-					{
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-					break;
-				}
-			}
-		}
-	}
-	return false;
+	return Board_CanMove(now, W);
 }
 
 bool Game::I_CanMove(int W)
 {
-	int move;
-	if (imitation.islt)
-	{
-		move = LT_SIGN;
-	}
-	else
-	{
-		move = RB_SIGN;
-	}
-	for (int i = 0; i < 5; i++)
-	{
-		for (int j = 0; j < 5; j++)
-		{
-			if (imitation.cb.set[i][j] == transform_W_D(W)*move)
-			{
-				switch (W % 3)
-				{
-				case 0:
-					if (i - move <= 4 && i - move >= 0)
-					{
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-					break;
-				case 1:
-					if (i - move <= 4 && i - move >= 0 && j - move <= 4 && j - move >= 0)
-					{
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-					break;
-				case 2:
-					if (j - move <= 4 && j - move >= 0)
-					{
-						return true;
-					}
-					else
-					{
-						return false;
-					}
-					break;
-				}
-			}
-		}
-	}
-	return false;
+	return Board_CanMove(imitation, W);
 }
 
 bool Game::N_MoveChessman(int W)
 {
-	int move;
-	if (now.islt)
-	{
-		move = LT_SIGN;
-	}
-	else
-	{
-		move = RB_SIGN;
-	}
-	for (int i = 0; i < 5; i++)
-	{
-		for (int j = 0; j < 5; j++)
-		{
-			if (now.cb.set[i][j] == transform_W_D(W)*move)
-			{
-				switch (W % 3)
-				{
-				case 0:
-					now.cb.set[i - move][j] = now.cb.set[i][j];
-					break;
-				case 1:
-					now.cb.set[i - move][j - move] = now.cb.set[i][j];
-					break;
-				case 2:
-					now.cb.set[i][j - move] = now.cb.set[i][j];
-					break;
-				}
-				now.cb.set[i][j] = 0;
-				now.islt = !now.islt;
-				return true;
-			}
-		}
-	}
-	return false;
+	return Board_MoveChessman(now, W);
 }
 
 bool Game::I_MoveChessman(int W)
 {
-	int move;
-	if (imitation.islt)
-	{
-		move = LT_SIGN;
-	}
-	else
-	{
-		move = RB_SIGN;
-	}
-	for (int i = 0; i < 5; i++)
-	{
-		for (int j = 0; j < 5; j++)
-		{
-			if (imitation.cb.set[i][j] == transform_W_D(W)*move)
-			{
-				switch (W % 3)
-				{
-				case 0:
-					imitation.cb.set[i - move][j] = imitation.cb.set[i][j];
-					break;
-				case 1:
-					imitation.cb.set[i - move][j - move] = imitation.cb.set[i][j];
-					break;
-				case 2:
-					imitation.cb.set[i][j - move] = imitation.cb.set[i][j];
-					break;
-				}
-				imitation.cb.set[i][j] = 0;
-				imitation.islt = !imitation.islt; 
-				return true;
-			}
-		}
-	}
-	return false;
+	return Board_MoveChessman(imitation, W);
 }
 
 void Game::Expansion()
 {
-	int start, end;
-	bool finded_l, finded_r;
-	finded_l = false;
-	finded_r = false;
-	for (int t = 0; !(finded_l && finded_r); t++)
+	successor next;
+	Board_Successor(now, Dice, next);
+	for (int k = 0; k < next.count; k++)
 	{
-		if (!finded_l)
-		{
-			start = ((Dice - 1 - t) * 3);
-		}
-		if (!finded_r)
-		{
-			end = ((Dice + t) * 3);
-		}
-		if (start < 0)
-		{
-			start = 0;
-			finded_l = true;
-		}
-		if (end > 18)
-		{
-			end = 18;
-			finded_r = true;
-		}
-		for (int j = start; j < end; j++)
-		{
-			I_Recover();
-			if (I_CanMove(j))
-			{
-				if (I_MoveChessman(j))
-				{
-					if (t == 0)
-					{
-						finded_l = true;
-						finded_r = true;
-
-					}
-					else
-					{
-						if (j < start + 3)
-						{
-							finded_l = true;
-						}
-						if (j >= end - 3)
-						{
-							finded_r = true;
-						}
-					}
-					tree.N_SetImitation(j);
-				}
-				else
-				{
-					InputBox(NULL, NULL, "debug in 320");
-				}
-			}
-		}
+		tree.N_SetImitation(next.way[k]);
 	}
-	limit_l = start;
-	limit_r = end;
+	limit_l = next.l;
+	limit_r = next.r;
 }
 
 void Game::Simulation()
 {
-	int start, end;
-	bool finded_l, finded_r;
-	for (int i = 0; i < NNUCT_NUM; i++)
-	{
+	successor next;
+	undo back;
+	float lt_win;
+	bool exact;
+	int ply;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(MCST_TIME);
+	for (int i = 0; MCST_TIME > 0 ? std::chrono::steady_clock::now() < deadline : i < NNUCT_NUM; i++)
+	{
+		exact = false;
+		ply = 0;
 		I_Recover();
 		tree.I_Recover();
 		if (I_MoveChessman(tree.N_FindMax(limit_l, limit_r)))
@@ -572,81 +326,49 @@ void Game::Simulation()
 		}
 		do
 		{
-			tem_chessboard = imitation;
+			//the tablebase or the race knows the chance of this state,no need to play it to the end.
+			if (table.Probe(imitation, lt_win) || race.Probe(imitation, lt_win))
+			{
+				exact = true;
+				break;
+			}
+			if (EVALUATE_CUTOFF > 0 && ply >= EVALUATE_CUTOFF)
+			{
+				lt_win = Evaluate_LtWin(imitation);
+				exact = true;
+				break;
+			}
+			if (ROLLOUT_CUTOFF > 0 && ply >= ROLLOUT_CUTOFF)
+			{
+				lt_win = float(rollout.Play(imitation, ROLLOUT_COUNT)) / ROLLOUT_COUNT;
+				exact = true;
+				break;
+			}
+			ply++;
 			//Dice = randomDiceList->GetRandom();
 			Dice = rand() % 6 + 1;
-			finded_l = false;
-			finded_r = false;
-			// before use stack must inital
-			stack_Inital();
 			//by the value of Dice,set nood in mcst;
-			for (int t = 0; !(finded_l && finded_r); t += 1)
+			Board_Successor(imitation, Dice, next);
+			for (int k = 0; k < next.count; k++)
 			{
-				if (!finded_l)
-				{
-					start = ((Dice - 1 - t) * 3);
-				}
-				if (!finded_r)
+				if (EVALUATE_PRIOR > 0)
 				{
-					end = ((Dice + t) * 3);
+					Board_MakeMove(imitation, next.way[k], back);
+					tree.I_SetImitation(next.way[k], Evaluate_LtWin(imitation), EVALUATE_PRIOR);
+					Board_UnmakeMove(imitation, back);
 				}
-				if (start < 0)
-				{
-					start = 0;
-					finded_l = true;
-				}
-				if (end > 18)
-				{
-					end = 18;
-					finded_r = true;
-				}
-				//ҪмI_CanMove޳
-				for (int j = start; j < end; j++)
+				else
 				{
-					imitation = tem_chessboard;
-					if (I_CanMove(j))
-					{
-						if (I_MoveChessman(j))
-						{
-							//can move,will create new seat to storage;
-							if (t == 0)
-							{
-								NN_stack.cb[j % 3] = imitation.cb;
-								finded_l = true;
-								finded_r = true;
-							}
-							else
-							{
-								if (j < start + 3)
-								{
-									//0-3
-									NN_stack.cb[j % 3] = imitation.cb;
-									finded_l = true;
-								}
-								if (j >= end - 3)
-								{
-									//3-6
-									NN_stack.cb[(j % 3) + 3] = imitation.cb;
-									finded_r = true;
-								}
-					 		}
-							tree.I_SetImitation(j);
-						}
-						else
-						{
-							InputBox(NULL, NULL, "debug in 406");
-						}
-					}
+					tree.I_SetImitation(next.way[k]);
 				}
 			}
-			imitation = tem_chessboard;
 			//I_FindMax() will be instead of NN
 			//reason:NN is too slow,in some nood ,the same state will be use the method of NN again,we need a switch,if this Dice was use,don't use NN method
 			if (tree.I_IsUsed(Dice))
 			{
-				if (I_MoveChessman(tree.I_FindMax(start, end)))
+				if (I_MoveChessman(tree.I_FindMax(next.l, next.r)))
 				{
-					tree.I_Move(tree.I_FindMax(start, end));
+					tree.I_Move(tree.I_FindMax(next.l, next.r));
 				}
 				else
 				{
@@ -655,6 +377,15 @@ void Game::Simulation()
 			}
 			else
 			{
+				// before use stack must inital
+				stack_Inital();
+				//only NN need the chessboard after every move.
+				for (int k = 0; k < next.count; k++)
+				{
+					Board_MakeMove(imitation, next.way[k], back);
+					NN_stack.cb[int(next.slot[k])] = imitation.cb;
+					Board_UnmakeMove(imitation, back);
+				}
 				NN_stack.choose = NeuralNetWork(NN_stack);
 				The_sum_of_gv++;
 				//must give a method for state which NN_stack.cb[tem]==zero
@@ -662,9 +393,9 @@ void Game::Simulation()
 				{
 					the_sum_of_non++;
 					//NN method get way is illegal,we use find max method
-					if (I_MoveChessman(tree.I_FindMax(start, end)))
+					if (I_MoveChessman(tree.I_FindMax(next.l, next.r)))
 					{
-						tree.I_Move(tree.I_FindMax(start, end));
+						tree.I_Move(tree.I_FindMax(next.l, next.r));
 					}
 					else
 					{
@@ -675,10 +406,10 @@ void Game::Simulation()
 				{
 					if (NN_stack.choose < 3)
 					{
-						if (I_MoveChessman(start + NN_stack.choose))
+						if (I_MoveChessman(next.l + NN_stack.choose))
 						{
 							tree.I_SetUse(Dice);
-							tree.I_Move(start + NN_stack.choose);
+							tree.I_Move(next.l + NN_stack.choose);
 						}
 						else
 						{
@@ -687,10 +418,10 @@ void Game::Simulation()
 					}
 					else
 					{
-						if (I_MoveChessman(end + NN_stack.choose - 6))
+						if (I_MoveChessman(next.r + NN_stack.choose - 6))
 						{
 							tree.I_SetUse(Dice);
-							tree.I_Move(end + NN_stack.choose - 6);
+							tree.I_Move(next.r + NN_stack.choose - 6);
 						}
 						else
 						{
@@ -700,7 +431,11 @@ void Game::Simulation()
 				}
 			}
 		} while (Judge(imitation) == 0);
-		if (Judge(imitation) == LT_SIGN)
+		if (exact)
+		{
+			tree.I_BackPropagation(lt_win);
+		}
+		else if (Judge(imitation) == LT_SIGN)
 		{
 			tree.I_BackPropagation(true);
 		}
@@ -711,54 +446,16 @@ void Game::Simulation()
 	}
 }
 
-int Game::Judge(state s)
+int Game::Judge(const state &s)
 {
-	int lt = 0;
-	int rb = 0;
-	if (s.cb.set[0][0] > 0)
-	{
-		return RB_SIGN;
-	}
-	if (s.cb.set[4][4] < 0)
-	{
-		return LT_SIGN;
-	}
-	for (int i = 0; i < 5; i++)
-	{
-		for (int j = 0; j < 5; j++)
-		{
-			if (s.cb.set[i][j] != 0)
-			{
-				if (s.cb.set[i][j] < 0)
-				{
-					lt++;
-				}
-				else
-				{
-					rb++;
-				}
-			 }
-		}
-	}
-	if (lt == 0)
-	{
-		return RB_SIGN;
-	}
-	else if (rb == 0)
-	{
-		return LT_SIGN;
-	}
-	else
-	{
-		return 0;
-	}
+	return Board_Judge(s);
 }
 
 bool Game::Is_Chessboard_Zero(chessboard tem)
 {
-	for (int i = 0; i < 5; i++)
+	for (int i = 0; i < BOARD_SIZE; i++)
 	{
-		for (int j = 0; j < 5; j++)
+		for (int j = 0; j < BOARD_SIZE; j++)
 		{
 			if (tem.set[i][j] != 0)
 			{
@@ -787,21 +484,21 @@ Record::~Record()
 
 void Record::Record_ChessBoard(chessboard temp)
 {
-	for (int i = 0; i < 5; i++)
+	for (int i = 0; i < BOARD_SIZE; i++)
 	{
-		for (int j = 0; j < 5; j++)
+		for (int j = 0; j < BOARD_SIZE; j++)
 		{
 			if (temp.set[i][j] != 0)
 			{
 				if (temp.set[i][j] < 0)
 				{
 					inital_r[abs(temp.set[i][j]) - 1][0] = char('A' + i);
-					inital_r[abs(temp.set[i][j]) - 1][1] = char('5' - j);
+					inital_r[abs(temp.set[i][j]) - 1][1] = char('0' + BOARD_SIZE - j);
 				}
 				else
 				{
 					inital_b[abs(temp.set[i][j]) - 1][0] = char('A' + i);
-					inital_b[abs(temp.set[i][j]) - 1][1] = char('5' - j);
+					inital_b[abs(temp.set[i][j]) - 1][1] = char('0' + BOARD_SIZE - j);
 				}
 			}
 		}
@@ -825,14 +522,14 @@ void Record::Record_Action(int dice, state temp, int tem_way)
 		sign = RB_SIGN;
 		v_tem->side = 'B';
 	}
-	for (int i = 0; i < 5; i++)
+	for (int i = 0; i < BOARD_SIZE; i++)
 	{
-		for (int j = 0; j < 5; j++)
+		for (int j = 0; j < BOARD_SIZE; j++)
 		{
 			if (temp.cb.set[i][j] == sign * chessman)
 			{
 				v_tem->x = char('A' + i);
-				v_tem->y = char('5' - j);
+				v_tem->y = char('0' + BOARD_SIZE - j);
 			}
 		}
 	}
@@ -1,19 +1,33 @@
 #pragma once
 #include"MCST.h"
 #include"NeuralNetwork.h"
+#include"Tablebase.h"
+#include"Expectimax.h"
+#include"Race.h"
+#include"Evaluate.h"
+#include"Setup.h"
+#include"Book.h"
+#include"Rollout.h"
 //in P V E mode,LT is ai's side.
-#define LT_SIGN -1
-#define RB_SIGN 1
 #define NNUCT_NUM 1000
+//which ai plays LT,the other one is only compiled in.
+#define ENGINE_MCST 0
+#define ENGINE_EXPECTIMAX 1
+#define AI_ENGINE ENGINE_MCST
+#define EXPECTIMAX_TIME 1000//ms for one move
+#define MCST_TIME 0//ms of playouts for one move of the tree,0 plays NNUCT_NUM playouts instead
+//Evaluate_LtWin() in Simulation(),0 is off for both.
+#define EVALUATE_PRIOR 0//playouts that the static value counts for in a new node
+#define EVALUATE_CUTOFF 0//moves of a playout before it stops and takes the static value
+//Rollout as the value of a leaf in Simulation(),0 is off.
+#define ROLLOUT_CUTOFF 0//moves of a playout before it stops and the batched playouts go on from there
+#define ROLLOUT_COUNT 64//batched playouts from that leaf
+//copy the tree in breadth first order after the player's move,it pays only when a search has many more playouts than the tree has nodes.
+#define TREE_COMPACT 0
 const string HOST_AI = "ʿ";
 const string PLAYER = "";
 const string TIME_PLACE = "2019/10/11";
 const string GAME_NAME = "test";
-struct state
-{
-	chessboard cb;
-	bool islt;
-};
 struct c_set
 {
 	char side;
@@ -49,6 +63,12 @@ public:
 private:
 	//RandomList *randomDiceList;
 	MCST tree;
+	Tablebase table;
+	Expectimax search;
+	Race race;
+	Rollout rollout;
+	Setup setup;
+	Book book;
 	Record note;
 	chessboard zero;//be used to fill zero in stack; 
 	Paint draw;
@@ -56,7 +76,7 @@ private:
 	state Record_now;
 	vector<state> the_line_of_time;
 	vector<statestack*> dataset;//
-	state imitation, tem_chessboard;
+	state imitation;
 	statestack NN_stack;//just be used to store temp data for neural-network in simuation(); 
 	int Way;//be used N 
 	int Dice;
@@ -82,7 +102,7 @@ private:
 	void Expansion();
 	//if four thread ,need four Simulation;
 	void Simulation();
-	int Judge(state s);
+	int Judge(const state &s);
 	bool Is_Chessboard_Zero(chessboard tem);
 };
 
@@ -1,57 +1,186 @@
 #include "MCST.h"
+#include<algorithm>
+#include<cmath>
+#include<cstdlib>
 
 
 
 MCST::MCST()
 {
 	//randomMaxList = new RandomList(10000, 11000);
-	root = new node();
+	arena = &arenas[0];
+	root = arena->New();
 	now = root;
+	imitation = root;
+	root_pass = 0;
 }
 
 
 MCST::~MCST()
 {
+	//nodes have nothing to destroy,so the tree is forgotten with the blocks and no worker is started for it.
+	arena->Drop();
 }
 
-void MCST::Calc_Val(node * tem)
+void MCST::Clear()
 {
-	//maybe we can create a confidence interval for neural network;
-	tem->value = tem->win / tem->pass + (sqrtf(log(root->pass) / tem->pass)*CONFIDENCE_INTERVAL);
+	arena->Reset(root);
+	root = arena->New();
+	now = root;
+	imitation = root;
+	root_pass = 0;
 }
 
-void MCST::N_SetImitation(int W)
+long long MCST::Nodes() const
+{
+	return arena->Live();
+}
+
+long long MCST::Queued() const
+{
+	return arenas[0].Queued() + arenas[1].Queued();
+}
+
+long long MCST::Freed() const
+{
+	return arenas[0].Freed() + arenas[1].Freed();
+}
+
+int MCST::Pending() const
+{
+	return arenas[0].Pending() + arenas[1].Pending();
+}
+
+void MCST::Compact()
 {
-	bool bool_tem = true;
-	for (int i = 0; i < now->next.size(); i++)
+	NodeArena *fresh = arena == &arenas[0] ? &arenas[1] : &arenas[0];
+	node *top = fresh->New();
+	node *new_now = top;
+	top->type = root->type;
+	std::copy(root->Dice, root->Dice + 6, top->Dice);
+	//breadth first,a node is copied when its ahead is,so the children of a node are next to each other.
+	compact.clear();
+	compact.push_back(std::make_pair(root, top));
+	for (size_t k = 0; k < compact.size(); k++)
 	{
-		if (now->next[i]->type == transform_W_S(W))
+		node *from = compact[k].first;
+		node *to = compact[k].second;
+		if (from == now)
 		{
-			bool_tem = false;
+			new_now = to;
+		}
+		nodechild **link = &to->child;
+		for (nodechild *c = from->child; c != NULL; c = c->sibling)
+		{
+			nodechild *copy = fresh->NewChild();
+			copy->man = c->man;
+			*link = copy;
+			link = &copy->sibling;
+			for (int i = 0; i < NODE_WAYS; i++)
+			{
+				copy->stat[i] = c->stat[i];
+				if (c->next[i] != NULL)
+				{
+					node *tem = fresh->New();
+					tem->ahead = to;
+					tem->type = c->next[i]->type;
+					std::copy(c->next[i]->Dice, c->next[i]->Dice + 6, tem->Dice);
+					copy->next[i] = tem;
+					compact.push_back(std::make_pair(c->next[i], tem));
+				}
+			}
 		}
 	}
-	if (bool_tem)
+	//every node of the old arena was copied,no need to walk them again.
+	arena->Drop();
+	arena = fresh;
+	root = top;
+	now = new_now;
+	imitation = now;
+}
+
+void MCST::Calc_Val(nodestat &tem)
+{
+	//maybe we can create a confidence interval for neural network;
+	//a child can have passes from its prior before the first playout ends,log(0) would make it nan.
+	float total = root_pass < 1 ? 1 : root_pass;
+	tem.value = tem.win / tem.pass + (sqrtf(log(total) / tem.pass)*CONFIDENCE_INTERVAL);
+}
+
+nodechild *MCST::Children(node *n, int W)
+{
+	nodechild *c = n->child;
+	while (c != NULL && c->man < W / NODE_WAYS)
+	{
+		c = c->sibling;
+	}
+	return c != NULL && c->man == W / NODE_WAYS ? c : NULL;
+}
+
+nodestat *MCST::NewChild(node *n, int W)
+{
+	//the one of a new man goes before the first bigger man,so they stay in order.
+	nodechild **link = &n->child;
+	while (*link != NULL && (*link)->man < W / NODE_WAYS)
+	{
+		link = &(*link)->sibling;
+	}
+	if (*link == NULL || (*link)->man != W / NODE_WAYS)
+	{
+		nodechild *c = arena->NewChild();
+		c->man = char(W / NODE_WAYS);
+		c->sibling = *link;
+		*link = c;
+	}
+	nodechild *c = *link;
+	int i = W % NODE_WAYS;
+	if (c->next[i] != NULL)
+	{
+		return NULL;
+	}
+	node *tem = arena->New();
+	tem->ahead = n;
+	tem->type = transform_W_S(W);
+	c->next[i] = tem;
+	c->stat[i].pass = 0;
+	c->stat[i].win = 0;
+	c->stat[i].value = 0;
+	return &c->stat[i];
+}
+
+void MCST::N_SetImitation(int W)
+{
+	nodestat *tem = NewChild(now, W);
+	if (tem != NULL)
 	{
-		node *tem = new node();
 		//
 		//tem->value = randomMaxList->GetRandom();
 		tem->value = rand() % 10 + 10000;
-		tem->ahead = now;
-		tem->type = transform_W_S(W);
-		now->next.push_back(tem);
 	}
 }
 
 void MCST::N_Move(int W)
 {
-	for (int i = 0; i < now->next.size(); i++)
+	nodechild *move = Children(now, W);
+	if (move == NULL || move->next[W % NODE_WAYS] == NULL)
+	{
+		return;
+	}
+	//the other moves can't be reached again,free them and keep the subtree of the move for the next search.
+	//the nodes of the line of the game stay,so N_BackStep() still has somewhere to go.
+	for (nodechild *c = now->child; c != NULL; c = c->sibling)
 	{
-		if (now->next[i]->type == transform_W_S(W))
+		for (int i = 0; i < NODE_WAYS; i++)
 		{
-			now = now->next[i];
-			break;
+			if ((c != move || i != W % NODE_WAYS) && c->next[i] != NULL)
+			{
+				arena->Free(c->next[i]);
+				c->next[i] = NULL;
+			}
 		}
 	}
+	now = move->next[W % NODE_WAYS];
+	imitation = now;
 }
 
 int MCST::N_FindMax(int L, int R)
@@ -59,67 +188,73 @@ int MCST::N_FindMax(int L, int R)
 	float max;
 	int sign;
 	max = -1;
-	for (int i = 0; i < now->next.size(); i++)
+	//L when no way of [L,R) is in the tree yet.
+	sign = L;
+	for (nodechild *c = now->child; c != NULL && c->man * NODE_WAYS < R; c = c->sibling)
 	{
-		if (now->next[i]->pass > 0)
+		for (int k = 0; k < NODE_WAYS; k++)
 		{
-			Calc_Val(now->next[i]);
+			int i = c->man * NODE_WAYS + k;
+			if (i < L || i >= R || c->next[k] == NULL)
+			{
+				continue;
+			}
+			nodestat &tem = c->stat[k];
+			if (tem.pass > 0)
+			{
+				Calc_Val(tem);
+			}
+			if (tem.value >= max)
+			{
+				sign = i;
+				max = tem.value;
+			}
 		}
-		if (now->next[i]->type >= transform_W_S(L) && now->next[i]->type < transform_W_S(R) && now->next[i]->value >= max)
-		{
-			sign = now->next[i]->type - 'A';
-			max = now->next[i]->value;
-		}	
 	}
 	return sign;
 } 
 
 void MCST::I_SetImitation(int W)
 {
-	bool bool_tem = true;
-	for (int i = 0; i < imitation->next.size(); i++)
+	nodestat *tem = NewChild(imitation, W);
+	if (tem != NULL)
 	{
-		if (imitation->next[i]->type == transform_W_S(W))
-		{
-			bool_tem = false;
-			break;
-		}
-	}
-	if (bool_tem)
-	{
-		node *tem = new node();
 		//
 		//tem->value = randomMaxList->GetRandom();
 		tem->value = rand() % 10 + 10000;
-		tem->ahead = imitation;
-		tem->type = transform_W_S(W);
-		imitation->next.push_back(tem);
+	}
+}
+
+void MCST::I_SetImitation(int W, float win, float pass)
+{
+	nodestat *tem = NewChild(imitation, W);
+	if (tem != NULL)
+	{
+		tem->pass = pass;
+		tem->win = win * pass;
 	}
 }
 
 void MCST::I_Move(int W)
 {
-	bool moved = false;
-	for (int i = 0; i < imitation->next.size(); i++)
+	nodechild *c = Children(imitation, W);
+	if (c != NULL && c->next[W % NODE_WAYS] != NULL)
 	{
-		if (imitation->next[i]->type == transform_W_S(W))
-		{
-			imitation = imitation->next[i];
-			break;
-		}
+		imitation = c->next[W % NODE_WAYS];
 	}
 }
 
-void MCST::I_BackPropagation(bool win)
+void MCST::I_BackPropagation(float win)
 {
-	for (; imitation != NULL; imitation = imitation->ahead)
+	for (; imitation->ahead != NULL; imitation = imitation->ahead)
 	{
-		imitation->pass += 1;
-		if (win)
-		{
-			imitation->win += 1;
-		}
+		int W = imitation->type - 'A';
+		nodestat &tem = Children(imitation->ahead, W)->stat[W % NODE_WAYS];
+		tem.pass += 1;
+		tem.win += win;
 	}
+	root_pass += 1;
+	imitation = NULL;
 }
 
 int MCST::I_FindMax(int L, int R)
@@ -127,16 +262,27 @@ int MCST::I_FindMax(int L, int R)
 	float max;
 	int sign;
 	max = -1;
-	for (int i = 0; i < imitation->next.size(); i++)
+	//L when no way of [L,R) is in the tree yet.
+	sign = L;
+	for (nodechild *c = imitation->child; c != NULL && c->man * NODE_WAYS < R; c = c->sibling)
 	{
-		if (imitation->next[i]->pass > 0)
-		{
-			Calc_Val(imitation->next[i]);
-		}
-		if (imitation->next[i]->type >= transform_W_S(L) && imitation->next[i]->type < transform_W_S(R) && imitation->next[i]->value>max)
+		for (int k = 0; k < NODE_WAYS; k++)
 		{
-			sign = imitation->next[i]->type - 'A';
-			max = imitation->next[i]->value;
+			int i = c->man * NODE_WAYS + k;
+			if (i < L || i >= R || c->next[k] == NULL)
+			{
+				continue;
+			}
+			nodestat &tem = c->stat[k];
+			if (tem.pass > 0)
+			{
+				Calc_Val(tem);
+			}
+			if (tem.value > max)
+			{
+				sign = i;
+				max = tem.value;
+			}
 		}
 	}
 	return sign;
@@ -2,40 +2,77 @@
 #include<vector>
 #include<thread>
 #include<mutex>
+#include<utility>
+#include"NodeArena.h"
 //#include"RandomList.h"
 #define CONFIDENCE_INTERVAL 0.68
+#define NODE_WAYS 3//ways of one chessman,a nodechild has a child for each at most
 using std::vector;
+struct nodestat
+{
+	float pass;
+	float win;
+	float value;
+};
+//the children of a node for the ways of one chessman,the child of way W and its statistics are at W % 3.
+//a node keeps one for every chessman which has a child,from the smallest man up,
+//so a FindMax reads one or two of them and no child,and a node only pays for the chessmen it tried.
+struct nodechild
+{
+	nodestat stat[NODE_WAYS];
+	char man;//W / 3 of the ways
+	node *next[NODE_WAYS];//NULL before the way is made
+	nodechild *sibling;//the one of the next bigger man,NULL at the last
+};
 struct node
 {
-	node *ahead;
-	char type;
-	bool choose = false;
-	bool Dice[6]; 
-	float pass = 0;
-	float win = 0;
-	float value = 0;
-	vector<node *> next;
+	node *ahead = NULL;
+	nodechild *child = NULL;//NULL until the first child,the statistics of a node are in the nodechild of its ahead
+	char type = 0;
+	bool Dice[6] = {};
 };
 class MCST
 {
 public:
 	MCST();
 	~MCST();
-	void Calc_Val(node *tem);
+	void Calc_Val(nodestat &tem);
 	void N_SetImitation(int W);
+	//the game goes on with W,the other children of now are freed.
 	void N_Move(int W);
 	int N_FindMax(int L, int R);
 	void I_SetImitation(int W);
+	//the new node starts as if it had pass playouts and won win of each,a prior from a static value.
+	void I_SetImitation(int W, float win, float pass);
 	void I_Move(int W);
-	void I_BackPropagation(bool win);
+	//win is 1 or 0 after a playout,or the chance of winning when it is known.
+	void I_BackPropagation(float win);
 	int I_FindMax(int L, int R);
 	void I_Recover();
 	bool I_IsUsed(int Dice);
 	void I_SetUse(int Dice);
 	void N_BackStep();
+	//free the whole tree and start again from a new root.
+	void Clear();
+	long long Nodes() const;
+	//the counters of the worker which frees old subtrees,for both arenas so Compact() doesn't lose them.
+	//nodes taken by the worker,nodes freed by it,subtrees not finished,see NodeArena.
+	long long Queued() const;
+	long long Freed() const;
+	int Pending() const;
+	//copy the tree to the other arena in breadth first order,so a search after many moves runs on nodes close together.
+	void Compact();
 private:
 //	RandomList *randomMaxList;
+	NodeArena arenas[2];//Compact() copies the tree from one to the other
+	NodeArena *arena;
+	vector<std::pair<node *, node *>> compact;//the old and the new node,for Compact()
 	char transform_W_S(int W);
+	//the nodechild of the man of way W under n,NULL when the man has no child yet.
+	nodechild *Children(node *n, int W);
+	//a new child of way W under n and its statistics,NULL when it is there.
+	nodestat *NewChild(node *n, int W);
 	node *root, *now;
 	node *imitation;
+	float root_pass;//root has no ahead to keep its statistics
 };
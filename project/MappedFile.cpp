@@ -0,0 +1,128 @@
+#include "MappedFile.h"
+#ifdef _WIN32
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+	data = NULL;
+	size = 0;
+#ifdef _WIN32
+	file = INVALID_HANDLE_VALUE;
+	mapping = NULL;
+#else
+	file = -1;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const char *path)
+{
+	Close();
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(file, &length) || length.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+	mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		Close();
+		return false;
+	}
+	data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL)
+	{
+		Close();
+		return false;
+	}
+	size = length.QuadPart;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data != NULL)
+	{
+		UnmapViewOfFile(data);
+	}
+	if (mapping != NULL)
+	{
+		CloseHandle(mapping);
+	}
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(file);
+	}
+	data = NULL;
+	size = 0;
+	mapping = NULL;
+	file = INVALID_HANDLE_VALUE;
+}
+#else
+bool MappedFile::Open(const char *path)
+{
+	Close();
+	file = open(path, O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size == 0)
+	{
+		Close();
+		return false;
+	}
+	void *map = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, file, 0);
+	if (map == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+	data = (const char *)map;
+	size = info.st_size;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (data != NULL)
+	{
+		munmap((void *)data, size);
+	}
+	if (file >= 0)
+	{
+		close(file);
+	}
+	data = NULL;
+	size = 0;
+	file = -1;
+}
+#endif
+
+const char *MappedFile::Data() const
+{
+	return data;
+}
+
+long long MappedFile::Size() const
+{
+	return size;
+}
@@ -0,0 +1,21 @@
+#pragma once
+//a read-only file mapped into memory,so big tables can be used without reading them.
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+	bool Open(const char *path);
+	void Close();
+	const char *Data() const;
+	long long Size() const;
+private:
+	const char *data;
+	long long size;
+#ifdef _WIN32
+	void *file;
+	void *mapping;
+#else
+	int file;
+#endif
+};
@@ -0,0 +1,324 @@
+#include "NodeArena.h"
+#include "MCST.h"
+#include<assert.h>
+#include<new>
+
+NodeArena::NodeArena()
+{
+	Inital(nodes, sizeof(node));
+	Inital(children, sizeof(nodechild));
+	live = 0;
+	stop = false;
+	queued = 0;
+	freed = 0;
+	pending = 0;
+	returned = false;
+	returned_nodes.head = returned_nodes.tail = NULL;
+	returned_children.head = returned_children.tail = NULL;
+}
+
+NodeArena::~NodeArena()
+{
+	Release();
+}
+
+void NodeArena::Inital(pool &p, size_t size)
+{
+	p.size = size;
+	p.current = 0;
+	p.used = NODE_ARENA_BLOCK;
+	p.free_list = NULL;
+}
+
+void *NodeArena::Take(pool &p)
+{
+	void *one;
+	if (p.free_list != NULL)
+	{
+		//a free one keeps the next free one where it was.
+		one = p.free_list;
+		p.free_list = *(void **)one;
+		return one;
+	}
+	if (p.used == NODE_ARENA_BLOCK)
+	{
+		//the next block,a new one when all are used.
+		p.current = p.block.empty() ? 0 : p.current + 1;
+		if (p.current == p.block.size())
+		{
+			p.block.push_back((char *)::operator new(p.size * NODE_ARENA_BLOCK));
+		}
+		p.used = 0;
+	}
+	one = p.block[p.current] + p.size * p.used;
+	p.used++;
+	return one;
+}
+
+void NodeArena::Give(pool &p, void *one)
+{
+	*(void **)one = p.free_list;
+	p.free_list = one;
+}
+
+void NodeArena::Rewind(pool &p)
+{
+	p.free_list = NULL;
+	p.current = 0;
+	p.used = p.block.empty() ? NODE_ARENA_BLOCK : 0;
+}
+
+bool NodeArena::Full(const pool &p)
+{
+	return p.free_list == NULL && p.used == NODE_ARENA_BLOCK && (p.block.empty() || p.current + 1 == p.block.size());
+}
+
+void NodeArena::Add(chain &c, void *one)
+{
+	*(void **)one = c.head;
+	if (c.head == NULL)
+	{
+		c.tail = one;
+	}
+	c.head = one;
+}
+
+void NodeArena::Join(chain &to, chain &c)
+{
+	if (c.head != NULL)
+	{
+		*(void **)c.tail = to.head;
+		if (to.head == NULL)
+		{
+			to.tail = c.tail;
+		}
+		to.head = c.head;
+	}
+}
+
+void NodeArena::Splice(pool &p, chain &c)
+{
+	if (c.head != NULL)
+	{
+		*(void **)c.tail = p.free_list;
+		p.free_list = c.head;
+	}
+	c.head = c.tail = NULL;
+}
+
+void NodeArena::Release(pool &p)
+{
+	for (size_t i = 0; i < p.block.size(); i++)
+	{
+		::operator delete(p.block[i]);
+	}
+	p.block.clear();
+	Inital(p, p.size);
+}
+
+node *NodeArena::New()
+{
+	if (nodes.free_list == NULL && (returned || (pending > 0 && Full(nodes))))
+	{
+		Collect();
+	}
+	live++;
+	return new (Take(nodes)) node();
+}
+
+nodechild *NodeArena::NewChild()
+{
+	if (children.free_list == NULL && (returned || (pending > 0 && Full(children))))
+	{
+		Collect();
+	}
+	return new (Take(children)) nodechild();
+}
+
+void NodeArena::Destroy(node *n)
+{
+	stack.push_back(n);
+	while (!stack.empty())
+	{
+		node *tem = stack.back();
+		stack.pop_back();
+		for (nodechild *c = tem->child, *sibling; c != NULL; c = sibling)
+		{
+			for (int i = 0; i < NODE_WAYS; i++)
+			{
+				if (c->next[i] != NULL)
+				{
+					stack.push_back(c->next[i]);
+				}
+			}
+			sibling = c->sibling;
+			c->~nodechild();
+			Give(children, c);
+		}
+		tem->~node();
+		Give(nodes, tem);
+		live--;
+	}
+}
+
+void NodeArena::Free(node *n)
+{
+	if (n == NULL)
+	{
+		return;
+	}
+	std::unique_lock<std::mutex> guard(lock);
+	if (!worker.joinable())
+	{
+		worker = std::thread(&NodeArena::Work, this);
+	}
+	done.wait(guard, [this] { return queue.size() < NODE_RECLAIM_QUEUE; });
+	queue.push_back(n);
+	pending++;
+	guard.unlock();
+	wake.notify_one();
+}
+
+void NodeArena::Collect()
+{
+	//wait only when nothing is back yet,New() calls it before it would take a new block.
+	std::unique_lock<std::mutex> guard(lock);
+	done.wait(guard, [this] { return returned || pending == 0; });
+	Splice(nodes, returned_nodes);
+	Splice(children, returned_children);
+	returned = false;
+}
+
+void NodeArena::Wait()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	done.wait(guard, [this] { return pending == 0; });
+}
+
+void NodeArena::Work()
+{
+	std::unique_lock<std::mutex> guard(lock);
+	for (;;)
+	{
+		wake.wait(guard, [this] { return stop || !queue.empty(); });
+		if (queue.empty())
+		{
+			return;
+		}
+		node *n = queue.back();
+		queue.pop_back();
+		guard.unlock();
+		//the subtree is only the worker's now,walk it without the lock.
+		chain n_chain = { NULL, NULL };
+		chain c_chain = { NULL, NULL };
+		long long count = 0;
+		worker_stack.push_back(n);
+		while (!worker_stack.empty())
+		{
+			node *tem = worker_stack.back();
+			worker_stack.pop_back();
+			for (nodechild *c = tem->child, *sibling; c != NULL; c = sibling)
+			{
+				for (int i = 0; i < NODE_WAYS; i++)
+				{
+					if (c->next[i] != NULL)
+					{
+						worker_stack.push_back(c->next[i]);
+					}
+				}
+				sibling = c->sibling;
+				c->~nodechild();
+				Add(c_chain, c);
+			}
+			tem->~node();
+			Add(n_chain, tem);
+			count++;
+			if ((count & 1023) == 0)
+			{
+				queued += 1024;
+			}
+		}
+		queued += count & 1023;
+		guard.lock();
+		Join(returned_nodes, n_chain);
+		Join(returned_children, c_chain);
+		freed += count;
+		returned = true;
+		pending--;
+		done.notify_all();
+	}
+}
+
+void NodeArena::Reset(node *root)
+{
+	Wait();
+	if (root != NULL)
+	{
+		Destroy(root);
+	}
+	assert(Live() == 0);
+	returned_nodes.head = returned_nodes.tail = NULL;
+	returned_children.head = returned_children.tail = NULL;
+	returned = false;
+	Rewind(nodes);
+	Rewind(children);
+}
+
+void NodeArena::Release()
+{
+	if (worker.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			stop = true;
+		}
+		wake.notify_one();
+		worker.join();
+		stop = false;
+	}
+	assert(Live() == 0);
+	returned_nodes.head = returned_nodes.tail = NULL;
+	returned_children.head = returned_children.tail = NULL;
+	returned = false;
+	Release(nodes);
+	Release(children);
+}
+
+void NodeArena::Drop()
+{
+	//the subtrees the worker has not started are forgotten with the rest,only wait for the one it walks.
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		pending -= int(queue.size());
+		queue.clear();
+	}
+	done.notify_all();
+	Wait();
+	live = freed;
+	Release();
+}
+
+long long NodeArena::Live() const
+{
+	return live - freed;
+}
+
+long long NodeArena::Capacity() const
+{
+	return (long long)nodes.block.size() * NODE_ARENA_BLOCK;
+}
+
+long long NodeArena::Queued() const
+{
+	return queued;
+}
+
+long long NodeArena::Freed() const
+{
+	return freed;
+}
+
+int NodeArena::Pending() const
+{
+	return pending;
+}
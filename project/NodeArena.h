@@ -0,0 +1,92 @@
+#pragma once
+#include<vector>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<atomic>
+using std::vector;
+struct node;
+struct nodechild;
+//nodes of MCST come from big blocks,so a new node costs no malloc and a whole tree can be given back at once.
+//a freed node goes on a free list and is used first by New(),the blocks are only given back by Release().
+//the children of a node come from the arena too,one nodechild for every chessman of it which has a child.
+//Free() gives the subtree to a worker thread and returns at once,the worker walks it and hands the nodes back,
+//New() takes them the next time its free list is empty.
+#define NODE_ARENA_BLOCK 4096//nodes in one block
+#define NODE_RECLAIM_QUEUE 64//subtrees waiting for the worker,Free() waits when there are more
+class NodeArena
+{
+public:
+	NodeArena();
+	~NodeArena();
+	node *New();
+	//the children of one chessman of a node,made when it gets its first child.
+	nodechild *NewChild();
+	//free n and every node under it,the caller takes n out of the children of its ahead.
+	//the nodes are freed by the worker later,no new block is taken while it still has some.
+	void Free(node *n);
+	//free the whole tree of root now,then New() goes through the blocks from the first again,so nodes stay in order.
+	void Reset(node *root);
+	//give back all blocks,every node must be freed before.
+	void Release();
+	//forget every node without walking them and give back all blocks,when nothing of the tree is used again.
+	void Drop();
+	//nodes in use(with the ones the worker has not freed yet),and nodes the blocks can hold.
+	long long Live() const;
+	long long Capacity() const;
+	//counters of the worker since the arena was made,Drop() doesn't reset them.
+	//Queued() and Freed() are nodes:the ones it has taken off its queue(counted while it walks a subtree)
+	//and the ones it has given back to New(),so Queued() - Freed() is the subtree it walks now.
+	//Pending() is subtrees it has not finished,the nodes of one are only known when it walks it.
+	long long Queued() const;
+	long long Freed() const;
+	int Pending() const;
+private:
+	//blocks of one size,nodes or children.
+	struct pool
+	{
+		vector<char *> block;
+		size_t size;//bytes of one
+		size_t current;//the block Take() takes from
+		int used;//taken from the current block
+		void *free_list;
+	};
+	//a list of freed ones made by the worker.
+	struct chain
+	{
+		void *head;
+		void *tail;
+	};
+	pool nodes;
+	pool children;
+	long long live;//New() minus Destroy(),the worker's are in freed
+	vector<node *> stack;//for Free() without recursion
+
+	std::thread worker;
+	std::mutex lock;
+	std::condition_variable wake;//for the worker,a subtree or stop
+	std::condition_variable done;//for New() and Free(),the worker finished a subtree
+	vector<node *> queue;
+	bool stop;
+	std::atomic<long long> queued;
+	std::atomic<long long> freed;
+	std::atomic<int> pending;
+	std::atomic<bool> returned;//the chains below have something
+	chain returned_nodes;
+	chain returned_children;
+	vector<node *> worker_stack;
+
+	static void Inital(pool &p, size_t size);
+	static void *Take(pool &p);
+	static void Give(pool &p, void *one);
+	static void Rewind(pool &p);
+	static void Release(pool &p);
+	static bool Full(const pool &p);
+	static void Add(chain &c, void *one);
+	static void Join(chain &to, chain &c);
+	static void Splice(pool &p, chain &c);
+	void Destroy(node *n);
+	void Collect();
+	void Wait();
+	void Work();
+};
@@ -4,7 +4,7 @@
 
 Paint::Paint()
 {
-	initgraph(600, 600);
+	initgraph(100 * BOARD_SIZE + 100, 100 * BOARD_SIZE + 100);
 }
 
 
@@ -17,19 +17,19 @@ void Paint::PaintChessboard()
 {
 	setfillcolor(WHITE);
 	setlinecolor(BLACK);
-	solidrectangle(0, 0, 600, 600);
-	for (int i = 0; i < 6; i++)
+	solidrectangle(0, 0, 100 * BOARD_SIZE + 100, 100 * BOARD_SIZE + 100);
+	for (int i = 0; i <= BOARD_SIZE; i++)
 	{
-		line(50, 100 * i + 50, 550, 100 * i + 50);
-		line(100 * i + 50, 50, 100 * i + 50, 550);
+		line(50, 100 * i + 50, 100 * BOARD_SIZE + 50, 100 * i + 50);
+		line(100 * i + 50, 50, 100 * i + 50, 100 * BOARD_SIZE + 50);
 	}
 }
 
 void Paint::PaintChessman(chessboard cb)
 {
-	for (int i = 0; i < 5; i++)
+	for (int i = 0; i < BOARD_SIZE; i++)
 	{
-		for (int j = 0; j < 5; j++)
+		for (int j = 0; j < BOARD_SIZE; j++)
 		{
 			if (cb.set[i][j] != 0)
 			{
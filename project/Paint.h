@@ -3,11 +3,8 @@
 #include<string>
 #include<fstream>
 #include<iostream>
+#include"Board.h"
 using std::string;
-struct chessboard
-{
-	int set[5][5];
-};
 
 class Paint
 {
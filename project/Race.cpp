@@ -0,0 +1,181 @@
+#include "Race.h"
+
+bool Race_IsRace(const state &s)
+{
+	for (int a = 0; a < 6; a++)
+	{
+		int p = s.seat[a];
+		if (p == BOARD_EATEN)
+		{
+			continue;
+		}
+		for (int b = 6; b < 12; b++)
+		{
+			int q = s.seat[b];
+			if (q != BOARD_EATEN && p / 5 <= q / 5 && p % 5 <= q % 5)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+Race::Race()
+{
+	table.resize(1 << RACE_TABLE_BITS);
+	for (int k = 0; k < int(table.size()); k++)
+	{
+		table[k].key = 0;
+	}
+}
+
+Race::~Race()
+{
+}
+
+//seat is the 6 seats of the side,key is only made of the chessman of the side.
+const raceentry &Race::Side(int side, char *seat, int alive, unsigned long long key)
+{
+	raceentry &e = table[key & (table.size() - 1)];
+	if (e.key == key)
+	{
+		return e;
+	}
+	int goal = side == 0 ? BOARD_GOAL_LT : BOARD_GOAL_RB;
+	float within[RACE_MAX_TURN] = {};
+	float move[6][RACE_MAX_TURN];
+	bool exact = true;
+	for (int dice = 0; dice < 6; dice++)
+	{
+		const dicemove &d = BOARD_DICE.at[alive][dice];
+		int count = 0;
+		for (int k = 0; k < 2; k++)
+		{
+			if (d.man[k] == 0)
+			{
+				continue;
+			}
+			int n = d.man[k] - 1;
+			int f = seat[n];
+			for (int way = 0; way < 3; way++)
+			{
+				int t = BOARD_MOVE.to[side][f][way];
+				if (t == BOARD_EATEN)
+				{
+					continue;
+				}
+				float *c = move[count++];
+				c[0] = 0;
+				if (t == goal)
+				{
+					for (int turn = 1; turn < RACE_MAX_TURN; turn++)
+					{
+						c[turn] = 1;
+					}
+					continue;
+				}
+				//it may eat a chessman of its own side.
+				int eaten = -1;
+				for (int m = 0; m < 6; m++)
+				{
+					if (seat[m] == t)
+					{
+						eaten = m;
+					}
+				}
+				unsigned long long next_key = key ^ BOARD_ZOBRIST.man[side * 6 + n][f] ^ BOARD_ZOBRIST.man[side * 6 + n][t];
+				int next_alive = alive;
+				if (eaten >= 0)
+				{
+					next_key ^= BOARD_ZOBRIST.man[side * 6 + eaten][t];
+					next_alive &= ~(1 << eaten);
+					seat[eaten] = BOARD_EATEN;
+				}
+				seat[n] = char(t);
+				const raceentry &next = Side(side, seat, next_alive, next_key);
+				seat[n] = char(f);
+				if (eaten >= 0)
+				{
+					seat[eaten] = char(t);
+				}
+				exact = exact && next.exact;
+				for (int turn = 1; turn < RACE_MAX_TURN; turn++)
+				{
+					c[turn] = next.within[turn - 1];
+				}
+			}
+		}
+		//the best move must be as good as all others for every k.
+		float best[RACE_MAX_TURN];
+		for (int turn = 0; turn < RACE_MAX_TURN; turn++)
+		{
+			best[turn] = 0;
+			for (int k = 0; k < count; k++)
+			{
+				best[turn] = move[k][turn] > best[turn] ? move[k][turn] : best[turn];
+			}
+			within[turn] += best[turn] / 6;
+		}
+		bool dominant = false;
+		for (int k = 0; k < count && !dominant; k++)
+		{
+			dominant = true;
+			for (int turn = 0; turn < RACE_MAX_TURN; turn++)
+			{
+				if (move[k][turn] < best[turn] - 1e-6f)
+				{
+					dominant = false;
+					break;
+				}
+			}
+		}
+		exact = exact && dominant;
+	}
+	//the slot may be used by the states after this one,write it again.
+	raceentry &save = table[key & (table.size() - 1)];
+	save.key = key;
+	save.exact = exact && within[RACE_MAX_TURN - 1] > 1 - 1e-6f;
+	for (int turn = 0; turn < RACE_MAX_TURN; turn++)
+	{
+		save.within[turn] = within[turn];
+	}
+	return save;
+}
+
+bool Race::Probe(const state &s, float &lt_win)
+{
+	if (s.goal != 0 || s.live[0] > RACE_MAX_PIECES || s.live[1] > RACE_MAX_PIECES || !Race_IsRace(s))
+	{
+		return false;
+	}
+	char seat[2][6];
+	unsigned long long key[2] = { 0, 0 };
+	for (int side = 0; side < 2; side++)
+	{
+		for (int n = 0; n < 6; n++)
+		{
+			seat[side][n] = s.seat[side * 6 + n];
+			if (seat[side][n] != BOARD_EATEN)
+			{
+				key[side] ^= BOARD_ZOBRIST.man[side * 6 + n][int(seat[side][n])];
+			}
+		}
+	}
+	int mover = s.islt ? 0 : 1;
+	//copy both,the second Side() may use the slot of the first.
+	raceentry me = Side(mover, seat[mover], s.alive[mover], key[mover]);
+	raceentry other = Side(1 - mover, seat[1 - mover], s.alive[1 - mover], key[1 - mover]);
+	if (!me.exact || !other.exact)
+	{
+		return false;
+	}
+	//the side to move goes first,it wins when it needs no more turns than the other.
+	float win = 0;
+	for (int turn = 1; turn < RACE_MAX_TURN; turn++)
+	{
+		win += (me.within[turn] - me.within[turn - 1]) * (1 - other.within[turn - 1]);
+	}
+	lt_win = s.islt ? win : 1 - win;
+	return true;
+}
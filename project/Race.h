@@ -0,0 +1,32 @@
+#pragma once
+#include"Board.h"
+#include<vector>
+using std::vector;
+//a race:no lt chessman can get to a seat that a rb chessman can get to,so the two sides never eat each other again.
+//then every side only wants to get its goal in as few turns as it can,and the turns of one side don't care about the other.
+//within[k] is the chance that one side gets its goal in at most k of its own turns,it is done for every side once and kept.
+//when one move is the best for every k,the side to move wins by sum over k of P(it needs k) * P(the other needs k or more).
+//if for some dice no move is the best for every k,how to play depends on the other side and Probe() says false.
+#define RACE_TABLE_BITS 15
+#define RACE_MAX_TURN 32
+#define RACE_MAX_PIECES 4//more chessman on one side make too many states
+struct raceentry
+{
+	unsigned long long key;
+	bool exact;
+	float within[RACE_MAX_TURN];
+};
+//true when the two sides can't meet again.
+bool Race_IsRace(const state &s);
+class Race
+{
+public:
+	Race();
+	~Race();
+	//false when s isn't a race or has no exact value.
+	bool Probe(const state &s, float &lt_win);
+private:
+	vector<raceentry> table;
+
+	const raceentry &Side(int side, char *seat, int alive, unsigned long long key);
+};
@@ -0,0 +1,286 @@
+#include "Rollout.h"
+#ifdef __AVX2__
+#include<immintrin.h>
+#endif
+
+static constexpr rollouttable ROLLOUT = Rollout_BuildTable();
+
+Rollout::Rollout(int lane, unsigned int seed, bool simd)
+{
+	this->lane = (lane + ROLLOUT_WIDTH - 1) / ROLLOUT_WIDTH * ROLLOUT_WIDTH;
+	this->simd = simd;
+	seat.resize(12 * this->lane);
+	alive.resize(2 * this->lane);
+	islt.resize(this->lane);
+	result.resize(this->lane);
+	rng.resize(this->lane);
+	owner.resize(this->lane);
+	for (int k = 0; k < this->lane; k++)
+	{
+		//xorshift must not start from 0.
+		rng[k] = (seed + k) * 2654435761u | 1;
+	}
+}
+
+Rollout::~Rollout()
+{
+}
+
+int Rollout::Play(const state &s, int count)
+{
+	int win = 0;
+	Play(&s, 1, count, &win);
+	return win;
+}
+
+void Rollout::Play(const state *leaf, int leaf_count, int count, int *win)
+{
+	int jobs = leaf_count * count;
+	int next = 0;
+	int running = 0;
+	for (int k = 0; k < leaf_count; k++)
+	{
+		win[k] = 0;
+	}
+	for (int k = 0; k < lane; k++)
+	{
+		owner[k] = -1;
+		result[k] = RB_SIGN;
+	}
+	do
+	{
+		//a board which was over gives its result and takes the next playout.
+		running = 0;
+		for (int k = 0; k < lane; k++)
+		{
+			for (;;)
+			{
+				if (owner[k] >= 0)
+				{
+					if (result[k] == 0)
+					{
+						running++;
+						break;
+					}
+					if (result[k] == LT_SIGN)
+					{
+						win[owner[k]]++;
+					}
+					owner[k] = -1;
+				}
+				if (next >= jobs)
+				{
+					break;
+				}
+				Load(k, leaf[next / count], next / count);
+				next++;
+			}
+		}
+		if (running > 0)
+		{
+			Step();
+		}
+	} while (running > 0);
+}
+
+void Rollout::Load(int k, const state &s, int job)
+{
+	for (int man = 0; man < 12; man++)
+	{
+		seat[man * lane + k] = s.seat[man];
+	}
+	alive[k] = s.alive[0];
+	alive[lane + k] = s.alive[1];
+	islt[k] = s.islt ? 1 : 0;
+	result[k] = Board_Judge(s);
+	owner[k] = job;
+}
+
+void Rollout::Step()
+{
+#ifdef __AVX2__
+	if (simd)
+	{
+		Step_AVX2(0, lane);
+		return;
+	}
+#endif
+	Step_Scalar(0, lane);
+}
+
+void Rollout::Step_Scalar(int from, int to)
+{
+	for (int k = from; k < to; k++)
+	{
+		if (result[k] != 0)
+		{
+			continue;
+		}
+		unsigned int x = rng[k];
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		int dice = int(((x >> 16) * 6) >> 16);
+		int side = 1 - islt[k];
+		int man = ROLLOUT.dice[alive[side * lane + k] * 6 + dice];
+		int m0 = man & 0xff;
+		int m1 = man >> 8;
+		int seat0 = m0 == 0 ? BOARD_EATEN : seat[(side * 6 + m0 - 1) * lane + k];
+		int seat1 = m1 == 0 ? BOARD_EATEN : seat[(side * 6 + m1 - 1) * lane + k];
+		int n0 = ROLLOUT.ways[side * 26 + seat0];
+		int n1 = ROLLOUT.ways[side * 26 + seat1];
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		rng[k] = x;
+		int r = int(((x >> 16) * unsigned(n0 + n1)) >> 16);
+		int mover, t;
+		if (r < n0)
+		{
+			mover = side * 6 + m0 - 1;
+			t = ROLLOUT.target[(side * 26 + seat0) * 4 + r];
+		}
+		else
+		{
+			mover = side * 6 + m1 - 1;
+			t = ROLLOUT.target[(side * 26 + seat1) * 4 + r - n0];
+		}
+		int alive_lt = 0, alive_rb = 0;
+		bool goal_lt = false, goal_rb = false;
+		for (int j = 0; j < 12; j++)
+		{
+			int &s = seat[j * lane + k];
+			if (j == mover)
+			{
+				s = t;
+			}
+			else if (s == t)
+			{
+				s = BOARD_EATEN;
+			}
+			if (j < 6)
+			{
+				alive_lt |= (s != BOARD_EATEN) << j;
+				goal_lt = goal_lt || s == BOARD_GOAL_LT;
+			}
+			else
+			{
+				alive_rb |= (s != BOARD_EATEN) << (j - 6);
+				goal_rb = goal_rb || s == BOARD_GOAL_RB;
+			}
+		}
+		alive[k] = alive_lt;
+		alive[lane + k] = alive_rb;
+		islt[k] = 1 - islt[k];
+		//the same order as Board_Judge().
+		if (goal_rb)
+		{
+			result[k] = RB_SIGN;
+		}
+		else if (goal_lt)
+		{
+			result[k] = LT_SIGN;
+		}
+		else if (alive_lt == 0)
+		{
+			result[k] = RB_SIGN;
+		}
+		else if (alive_rb == 0)
+		{
+			result[k] = LT_SIGN;
+		}
+	}
+}
+
+#ifdef __AVX2__
+static inline __m256i Rollout_Xorshift(__m256i x)
+{
+	x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+	x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+	return _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+}
+
+void Rollout::Step_AVX2(int from, int to)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i one = _mm256_set1_epi32(1);
+	const __m256i six = _mm256_set1_epi32(6);
+	const __m256i eaten = _mm256_set1_epi32(BOARD_EATEN);
+	const __m256i goal_lt_seat = _mm256_set1_epi32(BOARD_GOAL_LT);
+	const __m256i goal_rb_seat = _mm256_set1_epi32(BOARD_GOAL_RB);
+	const __m256i lt_sign = _mm256_set1_epi32(LT_SIGN);
+	const __m256i rb_sign = _mm256_set1_epi32(RB_SIGN);
+	const __m256i step = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i stride = _mm256_set1_epi32(lane);
+	for (int k = from; k < to; k += ROLLOUT_WIDTH)
+	{
+		__m256i res = _mm256_loadu_si256((const __m256i *)&result[k]);
+		__m256i active = _mm256_cmpeq_epi32(res, zero);
+		if (_mm256_movemask_epi8(active) == 0)
+		{
+			continue;
+		}
+		__m256i id = _mm256_add_epi32(_mm256_set1_epi32(k), step);
+		__m256i old_x = _mm256_loadu_si256((const __m256i *)&rng[k]);
+		__m256i x = Rollout_Xorshift(old_x);
+		__m256i dice = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(x, 16), six), 16);
+		__m256i lt = _mm256_loadu_si256((const __m256i *)&islt[k]);
+		__m256i side = _mm256_sub_epi32(one, lt);
+		__m256i is_rb = _mm256_cmpeq_epi32(side, one);
+		__m256i alive_side = _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i *)&alive[k]), _mm256_loadu_si256((const __m256i *)&alive[lane + k]), is_rb);
+		__m256i man = _mm256_i32gather_epi32(ROLLOUT.dice, _mm256_add_epi32(_mm256_mullo_epi32(alive_side, six), dice), 4);
+		__m256i m0 = _mm256_and_si256(man, _mm256_set1_epi32(0xff));
+		__m256i m1 = _mm256_srli_epi32(man, 8);
+		//man index is side * 6 + m - 1,m == 0 means no chessman,so its seat is BOARD_EATEN.
+		__m256i base = _mm256_sub_epi32(_mm256_mullo_epi32(side, six), one);
+		__m256i mi0 = _mm256_max_epi32(_mm256_add_epi32(base, m0), zero);
+		__m256i mi1 = _mm256_max_epi32(_mm256_add_epi32(base, m1), zero);
+		__m256i seat0 = _mm256_i32gather_epi32(seat.data(), _mm256_add_epi32(_mm256_mullo_epi32(mi0, stride), id), 4);
+		__m256i seat1 = _mm256_i32gather_epi32(seat.data(), _mm256_add_epi32(_mm256_mullo_epi32(mi1, stride), id), 4);
+		seat0 = _mm256_blendv_epi8(seat0, eaten, _mm256_cmpeq_epi32(m0, zero));
+		seat1 = _mm256_blendv_epi8(seat1, eaten, _mm256_cmpeq_epi32(m1, zero));
+		__m256i row = _mm256_mullo_epi32(side, _mm256_set1_epi32(26));
+		__m256i n0 = _mm256_i32gather_epi32(ROLLOUT.ways, _mm256_add_epi32(row, seat0), 4);
+		__m256i n1 = _mm256_i32gather_epi32(ROLLOUT.ways, _mm256_add_epi32(row, seat1), 4);
+		x = Rollout_Xorshift(x);
+		__m256i r = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(x, 16), _mm256_add_epi32(n0, n1)), 16);
+		__m256i first = _mm256_cmpgt_epi32(n0, r);
+		__m256i mover = _mm256_blendv_epi8(_mm256_add_epi32(base, m1), _mm256_add_epi32(base, m0), first);
+		__m256i from_seat = _mm256_blendv_epi8(seat1, seat0, first);
+		__m256i nth = _mm256_blendv_epi8(_mm256_sub_epi32(r, n0), r, first);
+		__m256i t = _mm256_i32gather_epi32(ROLLOUT.target, _mm256_add_epi32(_mm256_slli_epi32(_mm256_add_epi32(row, from_seat), 2), nth), 4);
+		__m256i alive_lt = zero, alive_rb = zero;
+		__m256i goal_lt = zero, goal_rb = zero;
+		for (int j = 0; j < 12; j++)
+		{
+			__m256i s = _mm256_loadu_si256((const __m256i *)&seat[j * lane + k]);
+			__m256i ns = _mm256_blendv_epi8(s, eaten, _mm256_cmpeq_epi32(s, t));
+			ns = _mm256_blendv_epi8(ns, t, _mm256_cmpeq_epi32(mover, _mm256_set1_epi32(j)));
+			ns = _mm256_blendv_epi8(s, ns, active);
+			_mm256_storeu_si256((__m256i *)&seat[j * lane + k], ns);
+			__m256i live = _mm256_andnot_si256(_mm256_cmpeq_epi32(ns, eaten), _mm256_set1_epi32(1 << (j % 6)));
+			if (j < 6)
+			{
+				alive_lt = _mm256_or_si256(alive_lt, live);
+				goal_lt = _mm256_or_si256(goal_lt, _mm256_cmpeq_epi32(ns, goal_lt_seat));
+			}
+			else
+			{
+				alive_rb = _mm256_or_si256(alive_rb, live);
+				goal_rb = _mm256_or_si256(goal_rb, _mm256_cmpeq_epi32(ns, goal_rb_seat));
+			}
+		}
+		_mm256_storeu_si256((__m256i *)&alive[k], alive_lt);
+		_mm256_storeu_si256((__m256i *)&alive[lane + k], alive_rb);
+		_mm256_storeu_si256((__m256i *)&rng[k], _mm256_blendv_epi8(old_x, x, active));
+		_mm256_storeu_si256((__m256i *)&islt[k], _mm256_blendv_epi8(lt, side, active));
+		//the same order as Board_Judge(),from the last check to the first one.
+		__m256i now = zero;
+		now = _mm256_blendv_epi8(now, lt_sign, _mm256_cmpeq_epi32(alive_rb, zero));
+		now = _mm256_blendv_epi8(now, rb_sign, _mm256_cmpeq_epi32(alive_lt, zero));
+		now = _mm256_blendv_epi8(now, lt_sign, goal_lt);
+		now = _mm256_blendv_epi8(now, rb_sign, goal_rb);
+		_mm256_storeu_si256((__m256i *)&result[k], _mm256_blendv_epi8(res, now, active));
+	}
+}
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+#include"Board.h"
+#include<vector>
+using std::vector;
+//random playouts for many boards in lockstep,every step rolls dice,moves and judges all boards at once.
+//boards are kept as structure of arrays:seat[man * lane + k] is the seat of man on board k.
+//with __AVX2__ it does 8 boards in one step of the loop,else one by one,both give the same result.
+#define ROLLOUT_WIDTH 8
+//tables for the step,int so that AVX2 can gather them.
+//dice[alive * 6 + dice - 1] = man[0] | man[1] << 8 of BOARD_DICE.
+//ways[side * 26 + seat] is how many ways the chessman has,target[(side * 26 + seat) * 4 + k] is the target of its k-th way.
+struct rollouttable
+{
+	int dice[64 * 6];
+	int ways[2 * 26];
+	int target[2 * 26 * 4];
+};
+constexpr rollouttable Rollout_BuildTable()
+{
+	rollouttable m = {};
+	for (int alive = 0; alive < 64; alive++)
+	{
+		for (int dice = 0; dice < 6; dice++)
+		{
+			m.dice[alive * 6 + dice] = BOARD_DICE.at[alive][dice].man[0] | BOARD_DICE.at[alive][dice].man[1] << 8;
+		}
+	}
+	for (int side = 0; side < 2; side++)
+	{
+		for (int seat = 0; seat < 26; seat++)
+		{
+			for (int way = 0; way < 3; way++)
+			{
+				int t = BOARD_MOVE.to[side][seat][way];
+				if (t != BOARD_EATEN)
+				{
+					m.target[(side * 26 + seat) * 4 + m.ways[side * 26 + seat]] = t;
+					m.ways[side * 26 + seat]++;
+				}
+			}
+		}
+	}
+	return m;
+}
+class Rollout
+{
+public:
+	//lane is how many boards play at once,seed makes the dice.
+	//simd false makes it step one board after another even with __AVX2__,to check the two against each other.
+	Rollout(int lane = ROLLOUT_WIDTH * 8, unsigned int seed = 2019, bool simd = true);
+	~Rollout();
+	//count playouts from s,return how many of them lt won.
+	int Play(const state &s, int count);
+	//count playouts from every leaf,win[k] is how many of them lt won from leaf[k].
+	void Play(const state *leaf, int leaf_count, int count, int *win);
+private:
+	int lane;
+	bool simd;
+	vector<int> seat;
+	vector<int> alive;
+	vector<int> islt;
+	vector<int> result;
+	vector<unsigned int> rng;
+	vector<int> owner;
+
+	void Load(int k, const state &s, int job);
+	void Step();
+	void Step_Scalar(int from, int to);
+#ifdef __AVX2__
+	void Step_AVX2(int from, int to);
+#endif
+};
@@ -0,0 +1,193 @@
+#include "Setup.h"
+#include "Evaluate.h"
+#include<algorithm>
+#include<cstring>
+#include<fstream>
+#include<thread>
+
+void Setup_Numbers(int permutation, char *number)
+{
+	char rest[6] = { 1, 2, 3, 4, 5, 6 };
+	int factorial = 120;
+	for (int k = 0; k < 6; k++)
+	{
+		int pick = permutation / factorial;
+		permutation %= factorial;
+		number[k] = rest[pick];
+		for (int m = pick; m < 5 - k; m++)
+		{
+			rest[m] = rest[m + 1];
+		}
+		if (k < 5)
+		{
+			factorial /= 5 - k;
+		}
+	}
+}
+
+void Setup_Place(chessboard &cb, int side, int permutation)
+{
+	char number[6];
+	Setup_Numbers(permutation, number);
+	for (int k = 0; k < 6; k++)
+	{
+		int seat = side == 0 ? SETUP_SEAT[k] : 24 - SETUP_SEAT[k];
+		cb.set[seat / 5][seat % 5] = side == 0 ? LT_SIGN * number[k] : RB_SIGN * number[k];
+	}
+}
+
+static unsigned int Setup_Random(unsigned int &seed)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+//both sides take the move with the best Evaluate_LtWin(),or the one which wins at once.
+static int Setup_Play(state &s, unsigned int &seed)
+{
+	successor next;
+	undo back;
+	while (Board_Judge(s) == 0)
+	{
+		Board_Successor(s, Setup_Random(seed) % 6 + 1, next);
+		bool islt = s.islt;
+		int best = next.way[0];
+		float best_value = -1;
+		for (int k = 0; k < next.count; k++)
+		{
+			Board_MakeMove(s, next.way[k], back);
+			float value = Board_Judge(s) != 0 ? 2 : (islt ? Evaluate_LtWin(s) : 1 - Evaluate_LtWin(s));
+			Board_UnmakeMove(s, back);
+			if (value > best_value)
+			{
+				best_value = value;
+				best = next.way[k];
+			}
+		}
+		Board_MakeMove(s, best, back);
+	}
+	return Board_Judge(s);
+}
+
+static bool Setup_Better(const setupentry &a, const setupentry &b)
+{
+	return a.win > b.win;
+}
+
+Setup::Setup()
+{
+	games = 0;
+	entry = NULL;
+}
+
+Setup::~Setup()
+{
+}
+
+void Setup::Build_Part(int thread, int thread_count)
+{
+	for (int p = thread; p < SETUP_COUNT; p += thread_count)
+	{
+		//the same seed for a permutation whatever the threads are.
+		unsigned int seed = 2654435761u * (p + 1);
+		int win = 0;
+		for (int g = 0; g < games; g++)
+		{
+			state s;
+			memset(&s.cb, 0, sizeof(s.cb));
+			Setup_Place(s.cb, 0, p);
+			Setup_Place(s.cb, 1, Setup_Random(seed) % SETUP_COUNT);
+			s.islt = g % 2 == 0;
+			Board_Inital(s);
+			if (Setup_Play(s, seed) == LT_SIGN)
+			{
+				win++;
+			}
+		}
+		built[p].permutation = (unsigned short)p;
+		built[p].reserve = 0;
+		built[p].win = float(win) / games;
+	}
+}
+
+void Setup::Build(int games, int thread_count)
+{
+	if (thread_count < 1)
+	{
+		thread_count = 1;
+	}
+	file.Close();
+	this->games = games;
+	built.assign(SETUP_COUNT, setupentry());
+	vector<std::thread> worker;
+	for (int t = 1; t < thread_count; t++)
+	{
+		worker.push_back(std::thread(&Setup::Build_Part, this, t, thread_count));
+	}
+	Build_Part(0, thread_count);
+	for (size_t t = 0; t < worker.size(); t++)
+	{
+		worker[t].join();
+	}
+	std::stable_sort(built.begin(), built.end(), Setup_Better);
+	entry = built.data();
+}
+
+bool Setup::Save(const char *path)
+{
+	std::ofstream out(path, std::ios::binary);
+	if (!out.is_open() || entry == NULL)
+	{
+		return false;
+	}
+	setupheader header = {};
+	strcpy(header.magic, SETUP_MAGIC);
+	header.count = SETUP_COUNT;
+	header.games = games;
+	out.write((const char *)&header, sizeof(header));
+	out.write((const char *)entry, sizeof(setupentry) * SETUP_COUNT);
+	return out.good();
+}
+
+bool Setup::Open(const char *path)
+{
+	entry = NULL;
+	games = 0;
+	built.clear();
+	if (!file.Open(path) || file.Size() < (long long)(sizeof(setupheader) + sizeof(setupentry) * SETUP_COUNT))
+	{
+		file.Close();
+		return false;
+	}
+	const setupheader *header = (const setupheader *)file.Data();
+	if (strncmp(header->magic, SETUP_MAGIC, 8) != 0 || header->count != SETUP_COUNT)
+	{
+		file.Close();
+		return false;
+	}
+	games = header->games;
+	entry = (const setupentry *)(file.Data() + sizeof(setupheader));
+	return true;
+}
+
+int Setup::Count() const
+{
+	return entry == NULL ? 0 : SETUP_COUNT;
+}
+
+const setupentry &Setup::Rank(int rank) const
+{
+	return entry[rank];
+}
+
+bool Setup::Place(chessboard &cb, int side) const
+{
+	if (entry == NULL)
+	{
+		return false;
+	}
+	Setup_Place(cb, side, entry[0].permutation);
+	return true;
+}
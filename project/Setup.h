@@ -0,0 +1,51 @@
+#pragma once
+#include"Board.h"
+#include"MappedFile.h"
+#include<vector>
+using std::vector;
+//the 720 ways to number the chessman on the start triangle,ranked by self-play against random setups of the other side.
+//numbers[k] goes on SETUP_SEAT[k] of lt,rb uses the same numbers on 24 - SETUP_SEAT[k] so both sides share one table.
+//a permutation is its index in lexicographic order,0 is 1 2 3 4 5 6.
+//file:setupheader,then SETUP_COUNT setupentry from the best to the worst.
+#define SETUP_FILE "setup.bin"
+#define SETUP_MAGIC "WTNSU01"
+#define SETUP_COUNT 720
+const int SETUP_SEAT[6] = { 0, 1, 2, 5, 6, 10 };
+struct setupheader
+{
+	char magic[8];
+	int count;
+	int games;
+};
+struct setupentry
+{
+	unsigned short permutation;
+	unsigned short reserve;
+	float win;//chance of winning with it,half of the games are first-hand
+};
+void Setup_Numbers(int permutation, char *number);
+//put the numbers of permutation on the triangle of side,0 is lt and 1 is rb.
+void Setup_Place(chessboard &cb, int side, int permutation);
+class Setup
+{
+public:
+	Setup();
+	~Setup();
+	//play games of every permutation against random ones,each thread takes every thread_count-th permutation.
+	void Build(int games, int thread_count);
+	bool Save(const char *path);
+	//map a file made by Save(),false when it is missing or broken.
+	bool Open(const char *path);
+	int Count() const;
+	//rank 0 is the best.
+	const setupentry &Rank(int rank) const;
+	//the best setup for side,false when there is no table and cb is left alone.
+	bool Place(chessboard &cb, int side) const;
+private:
+	int games;
+	vector<setupentry> built;
+	const setupentry *entry;
+	MappedFile file;
+
+	void Build_Part(int thread, int thread_count);
+};
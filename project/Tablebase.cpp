@@ -0,0 +1,280 @@
+#include "Tablebase.h"
+#include<cstring>
+#include<fstream>
+#include<thread>
+
+static int Tablebase_Count(int alive)
+{
+	int count = 0;
+	for (; alive != 0; alive &= alive - 1)
+	{
+		count++;
+	}
+	return count;
+}
+
+static long long Tablebase_Power(int n)
+{
+	long long power = 1;
+	for (int k = 0; k < n; k++)
+	{
+		power *= 25;
+	}
+	return power;
+}
+
+Tablebase::Tablebase()
+{
+	pieces = 0;
+	value = NULL;
+	memset(material_of, -1, sizeof(material_of));
+}
+
+Tablebase::~Tablebase()
+{
+}
+
+void Tablebase::Inital_Material(int pieces)
+{
+	this->pieces = pieces;
+	material.clear();
+	memset(material_of, -1, sizeof(material_of));
+	long long offset = 0;
+	for (int count = 2; count <= pieces; count++)
+	{
+		for (int lt = 1; lt < 64; lt++)
+		{
+			for (int rb = 1; rb < 64; rb++)
+			{
+				if (BOARD_RELABEL.canonical[lt] != lt || BOARD_RELABEL.canonical[rb] != rb || Tablebase_Count(lt) + Tablebase_Count(rb) != count)
+				{
+					continue;
+				}
+				tablebasematerial m = {};
+				m.lt = (unsigned char)lt;
+				m.rb = (unsigned char)rb;
+				m.count = (unsigned char)count;
+				m.offset = offset;
+				material_of[lt][rb] = int(material.size());
+				material.push_back(m);
+				offset += 2 * Tablebase_Power(count);
+			}
+		}
+	}
+}
+
+long long Tablebase::Index(unsigned long long pack) const
+{
+	int alive[2] = { 0, 0 };
+	long long index = 0;
+	long long power = 1;
+	for (int man = 0; man < 12; man++)
+	{
+		int seat = (pack >> (man * 5)) & 31;
+		if (seat != BOARD_EATEN)
+		{
+			alive[man / 6] |= 1 << (man % 6);
+			index += seat * power;
+			power *= 25;
+		}
+	}
+	const tablebasematerial &m = material[material_of[alive[0]][alive[1]]];
+	if ((pack >> BOARD_PACK_LT) & 1)
+	{
+		index += power;
+	}
+	return m.offset + index;
+}
+
+int Tablebase::Pieces() const
+{
+	return pieces;
+}
+
+bool Tablebase::Probe(const state &s, float &lt_win) const
+{
+	if (value == NULL || s.live[0] + s.live[1] > pieces)
+	{
+		return false;
+	}
+	int result = Board_Judge(s);
+	if (result != 0)
+	{
+		lt_win = result == LT_SIGN ? 1.0f : 0.0f;
+		return true;
+	}
+	bool mirrored;
+	lt_win = value[Index(Board_Canonical(s, mirrored))] / float(TABLEBASE_SCALE);
+	return true;
+}
+
+//the expectimax value of a state which isn't over,every state after it must be done.
+float Tablebase::Value(const state &s) const
+{
+	state next = s;
+	successor way;
+	undo back;
+	float sum = 0;
+	for (int dice = 1; dice <= 6; dice++)
+	{
+		Board_Successor(next, dice, way);
+		float best = s.islt ? 0.0f : 1.0f;
+		for (int k = 0; k < way.count; k++)
+		{
+			float lt_win;
+			Board_MakeMove(next, way.way[k], back);
+			Probe(next, lt_win);
+			Board_UnmakeMove(next, back);
+			if (s.islt ? lt_win > best : lt_win < best)
+			{
+				best = lt_win;
+			}
+		}
+		sum += best;
+	}
+	return sum / 6;
+}
+
+void Tablebase::Build_Level(const tablebasematerial &m, const vector<int> &level, int thread, int thread_count)
+{
+	long long size = Tablebase_Power(m.count);
+	for (size_t k = thread; k < level.size(); k += thread_count)
+	{
+		//seats of the material from the index,then both sides to move.
+		unsigned long long pack = 0;
+		int index = level[k];
+		int n = 0;
+		for (int man = 0; man < 12; man++)
+		{
+			int alive = man < 6 ? m.lt : m.rb;
+			unsigned long long seat = BOARD_EATEN;
+			if (alive & (1 << (man % 6)))
+			{
+				seat = index / int(Tablebase_Power(n)) % 25;
+				n++;
+			}
+			pack |= seat << (man * 5);
+		}
+		//Probe() looks for the smaller one of a state and its mirror,the other one is never read.
+		if (Board_MirrorPack(pack) < pack)
+		{
+			continue;
+		}
+		for (int lt = 0; lt < 2; lt++)
+		{
+			state s;
+			Board_Unpack(pack | ((unsigned long long)lt << BOARD_PACK_LT), s);
+			int result = Board_Judge(s);
+			float lt_win = result != 0 ? (result == LT_SIGN ? 1.0f : 0.0f) : Value(s);
+			built[m.offset + lt * size + index] = (unsigned short)(lt_win * TABLEBASE_SCALE + 0.5f);
+		}
+	}
+}
+
+void Tablebase::Build(int pieces, int thread_count)
+{
+	if (pieces > TABLEBASE_MAX_PIECES)
+	{
+		pieces = TABLEBASE_MAX_PIECES;
+	}
+	if (thread_count < 1)
+	{
+		thread_count = 1;
+	}
+	file.Close();
+	Inital_Material(pieces);
+	const tablebasematerial &last = material[material.size() - 1];
+	built.assign(last.offset + 2 * Tablebase_Power(last.count), 0);
+	value = built.data();
+	this->pieces = 1;
+	for (size_t i = 0; i < material.size(); i++)
+	{
+		const tablebasematerial &m = material[i];
+		//Probe() may only look at materials which are done,they all have fewer chessman.
+		this->pieces = m.count;
+		long long size = Tablebase_Power(m.count);
+		vector<vector<int> > level(8 * m.count + 1);
+		for (int index = 0; index < size; index++)
+		{
+			int used = 0;
+			int progress = 0;
+			int rest = index;
+			bool valid = true;
+			for (int man = 0; man < 12 && valid; man++)
+			{
+				int alive = man < 6 ? m.lt : m.rb;
+				if (alive & (1 << (man % 6)))
+				{
+					int seat = rest % 25;
+					rest /= 25;
+					valid = !(used & (1 << seat));
+					used |= 1 << seat;
+					progress += man < 6 ? seat / 5 + seat % 5 : 8 - seat / 5 - seat % 5;
+				}
+			}
+			if (valid)
+			{
+				level[progress].push_back(index);
+			}
+		}
+		for (int p = 8 * m.count; p >= 0; p--)
+		{
+			vector<std::thread> worker;
+			for (int t = 1; t < thread_count; t++)
+			{
+				worker.push_back(std::thread(&Tablebase::Build_Level, this, std::cref(m), std::cref(level[p]), t, thread_count));
+			}
+			Build_Level(m, level[p], 0, thread_count);
+			for (size_t t = 0; t < worker.size(); t++)
+			{
+				worker[t].join();
+			}
+		}
+	}
+	this->pieces = pieces;
+}
+
+bool Tablebase::Save(const char *path)
+{
+	std::ofstream out(path, std::ios::binary);
+	if (!out.is_open())
+	{
+		return false;
+	}
+	tablebaseheader header = {};
+	strcpy(header.magic, TABLEBASE_MAGIC);
+	header.pieces = pieces;
+	header.material_count = int(material.size());
+	out.write((const char *)&header, sizeof(header));
+	out.write((const char *)material.data(), sizeof(tablebasematerial) * material.size());
+	out.write((const char *)value, sizeof(unsigned short) * built.size());
+	return out.good();
+}
+
+bool Tablebase::Open(const char *path)
+{
+	value = NULL;
+	pieces = 0;
+	built.clear();
+	if (!file.Open(path) || file.Size() < (long long)sizeof(tablebaseheader))
+	{
+		return false;
+	}
+	const tablebaseheader *header = (const tablebaseheader *)file.Data();
+	if (strncmp(header->magic, TABLEBASE_MAGIC, 8) != 0 || header->pieces < 2 || header->pieces > TABLEBASE_MAX_PIECES)
+	{
+		file.Close();
+		return false;
+	}
+	Inital_Material(header->pieces);
+	const tablebasematerial &last = material[material.size() - 1];
+	long long need = sizeof(tablebaseheader) + sizeof(tablebasematerial) * material.size() + sizeof(unsigned short) * (last.offset + 2 * Tablebase_Power(last.count));
+	if (header->material_count != int(material.size()) || file.Size() < need)
+	{
+		file.Close();
+		pieces = 0;
+		return false;
+	}
+	value = (const unsigned short *)(file.Data() + sizeof(tablebaseheader) + sizeof(tablebasematerial) * material.size());
+	return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include"Board.h"
+#include"MappedFile.h"
+#include<vector>
+using std::vector;
+//exact chance of lt winning for every state with at most pieces chessman,dice averaged,lt max and rb min over moves.
+//a move never goes back and an eat makes fewer chessman,so states are done from fewer chessman to more,
+//and in one material from the most progress to the least,states of one level don't need each other and are done by threads.
+//file:tablebaseheader,material_count tablebasematerial,then values as unsigned short(TABLEBASE_SCALE is 1.0).
+//a material is lt and rb alive masks after Board_RelabelPack(),its values are 25^n for rb to move then 25^n for lt to move,
+//the index is the sum of seat * 25^k,k goes over alive lt numbers and then alive rb numbers.
+//a state is looked up by Board_Canonical(),the value of a state whose mirror is smaller is left 0.
+#define TABLEBASE_FILE "tablebase.bin"
+#define TABLEBASE_MAGIC "WTNTB02"
+#define TABLEBASE_SCALE 65535
+#define TABLEBASE_MAX_PIECES 4
+struct tablebaseheader
+{
+	char magic[8];
+	int pieces;
+	int material_count;
+};
+struct tablebasematerial
+{
+	unsigned char lt;
+	unsigned char rb;
+	unsigned char count;
+	unsigned char reserve[5];
+	long long offset;
+};
+class Tablebase
+{
+public:
+	Tablebase();
+	~Tablebase();
+	//compute all states with at most pieces chessman in memory.
+	void Build(int pieces, int thread_count);
+	bool Save(const char *path);
+	//map a file made by Save(),false when it is missing or broken.
+	bool Open(const char *path);
+	int Pieces() const;
+	//false when s has more chessman than the table.
+	bool Probe(const state &s, float &lt_win) const;
+private:
+	int pieces;
+	vector<tablebasematerial> material;
+	int material_of[64][64];
+	vector<unsigned short> built;
+	const unsigned short *value;
+	MappedFile file;
+
+	void Inital_Material(int pieces);
+	long long Index(unsigned long long pack) const;
+	float Value(const state &s) const;
+	void Build_Level(const tablebasematerial &m, const vector<int> &level, int thread, int thread_count);
+};
@@ -0,0 +1,93 @@
+//benchmark:playouts through an MCST tree which was grown over some moves,before and after MCST::Compact().
+//the tree is built twice the same way and one is compacted,then both run the same playouts,
+//every ply goes down the tree with I_FindMax() like Simulation() does,the ways chosen must be the same.
+//g++ -O2 -std=c++14 -pthread -I.. CompactBench.cpp ../MCST.cpp ../NodeArena.cpp -o CompactBench
+#include"Board.h"
+#include"MCST.h"
+#include<chrono>
+#include<cstdlib>
+#include<iostream>
+#define BENCH_MOVES 4//moves played while the tree grows,the moves not played are freed and used again
+#define BENCH_BUILD 20000//playouts before each of them
+#define BENCH_RUN 5000//playouts that are timed
+
+//hash keeps every way chosen,plies counts the steps down the tree.
+void Bench_Playout(MCST &tree, const state &start, int count, unsigned long long &hash, long long &plies)
+{
+	state s;
+	successor next;
+	undo back;
+	for (int p = 0; p < count; p++)
+	{
+		s = start;
+		tree.I_Recover();
+		do
+		{
+			Board_Successor(s, rand() % 6 + 1, next);
+			for (int k = 0; k < next.count; k++)
+			{
+				tree.I_SetImitation(next.way[k]);
+			}
+			int W = tree.I_FindMax(next.l, next.r);
+			tree.I_Move(W);
+			Board_MakeMove(s, W, back);
+			hash = (hash ^ W) * 1099511628211ull;
+			plies++;
+		} while (Board_Judge(s) == 0);
+		tree.I_BackPropagation(Board_Judge(s) == LT_SIGN);
+	}
+}
+
+//play BENCH_MOVES moves with a search before each,s is the state after them.
+void Bench_Build(MCST &tree, state &s)
+{
+	successor next;
+	undo back;
+	unsigned long long hash = 0;
+	long long plies = 0;
+	for (int m = 0; m < BENCH_MOVES && Board_Judge(s) == 0; m++)
+	{
+		Bench_Playout(tree, s, BENCH_BUILD, hash, plies);
+		Board_Successor(s, rand() % 6 + 1, next);
+		for (int k = 0; k < next.count; k++)
+		{
+			tree.N_SetImitation(next.way[k]);
+		}
+		int W = tree.N_FindMax(next.l, next.r);
+		tree.N_Move(W);
+		Board_MakeMove(s, W, back);
+	}
+}
+
+int main()
+{
+	const char *name[2] = { "scattered: ", "compacted: " };
+	state start;
+	Board_AutoNumber(start.cb);
+	start.islt = true;
+	Board_Inital(start);
+	MCST tree[2];
+	state s[2];
+	for (int version = 0; version < 2; version++)
+	{
+		srand(2019);
+		s[version] = start;
+		Bench_Build(tree[version], s[version]);
+	}
+	auto begin = std::chrono::steady_clock::now();
+	tree[1].Compact();
+	double compact_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	std::cout << "tree of " << tree[1].Nodes() << " nodes compacted in " << compact_time * 1000 << " ms" << std::endl;
+	unsigned long long hash[2] = { 0, 0 };
+	for (int version = 0; version < 2; version++)
+	{
+		long long plies = 0;
+		srand(1);
+		begin = std::chrono::steady_clock::now();
+		Bench_Playout(tree[version], s[version], BENCH_RUN, hash[version], plies);
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		std::cout << name[version] << BENCH_RUN / time << " playouts/s, " << plies / time << " plies/s" << std::endl;
+	}
+	std::cout << (hash[0] == hash[1] ? "same ways chosen" : "DIFFERENT ways chosen") << std::endl;
+	return hash[0] == hash[1] ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+//benchmark:random playouts which build the moved chessboards for every legal way like Simulation() does for NN,
+//once by copying the state for every trial move,once by Board_MakeMove()/Board_UnmakeMove().
+//g++ -O2 -std=c++14 -I.. MakeMoveBench.cpp ../Board.cpp -o MakeMoveBench
+#include"Board.h"
+#include<chrono>
+#include<iostream>
+#include<random>
+#define BENCH_PLAYOUT 200000
+
+//return the wins of lt,copied is the bytes of state/chessboard/undo which were copied.
+//stack_sum only keeps the compiler from dropping the chessboards we build.
+long long Bench_Playout(bool make_unmake, unsigned int seed, long long &copied, long long &stack_sum)
+{
+	std::mt19937 gen(seed);
+	state start, s, tem;
+	chessboard stack[6];
+	successor next;
+	undo back;
+	long long win = 0;
+	Board_AutoNumber(start.cb);
+	start.islt = true;
+	Board_Inital(start);
+	copied = 0;
+	stack_sum = 0;
+	for (int p = 0; p < BENCH_PLAYOUT; p++)
+	{
+		s = start;
+		copied += sizeof(state);
+		do
+		{
+			int dice = gen() % 6 + 1;
+			Board_Successor(s, dice, next);
+			for (int k = 0; k < next.count; k++)
+			{
+				if (make_unmake)
+				{
+					Board_MakeMove(s, next.way[k], back);
+					stack[int(next.slot[k])] = s.cb;
+					Board_UnmakeMove(s, back);
+					copied += sizeof(undo) + sizeof(chessboard);
+				}
+				else
+				{
+					tem = s;
+					Board_MoveChessman(tem, next.way[k]);
+					stack[int(next.slot[k])] = tem.cb;
+					copied += sizeof(state) + sizeof(chessboard);
+				}
+			}
+			stack_sum += stack[int(next.slot[0])].set[2][2];
+			Board_MoveChessman(s, next.way[gen() % next.count]);
+		} while (Board_Judge(s) == 0);
+		if (Board_Judge(s) == LT_SIGN)
+		{
+			win++;
+		}
+	}
+	return win;
+}
+
+int main()
+{
+	const char *name[2] = { "copy state:  ", "make/unmake: " };
+	for (int version = 0; version < 2; version++)
+	{
+		long long copied, stack_sum;
+		auto start = std::chrono::steady_clock::now();
+		long long win = Bench_Playout(version == 1, 2019, copied, stack_sum);
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << name[version] << BENCH_PLAYOUT / time << " playouts/s, "
+			<< double(copied) / BENCH_PLAYOUT << " bytes copied/playout (lt win " << win << ", check " << stack_sum << ")" << std::endl;
+	}
+	return 0;
+}
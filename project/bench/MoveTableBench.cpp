@@ -0,0 +1,91 @@
+//micro-benchmark:target seat from BOARD_MOVE against the switch (W % 3) with bounds check we used before.
+//g++ -O2 -std=c++14 -I.. MoveTableBench.cpp ../Board.cpp -o MoveTableBench
+#include"Board.h"
+#include<chrono>
+#include<iostream>
+#include<random>
+#define BENCH_INPUT 4096
+#define BENCH_ROUND 20000
+
+//the old way in Game::I_CanMove/I_MoveChessman,return BOARD_EATEN when it is out of chessboard.
+int Switch_Target(int side, int seat, int way)
+{
+	if (seat == BOARD_EATEN)
+	{
+		return BOARD_EATEN;
+	}
+	int move = side == 0 ? LT_SIGN : RB_SIGN;
+	int i = seat / 5;
+	int j = seat % 5;
+	switch (way)
+	{
+	case 0:
+		if (i - move <= 4 && i - move >= 0)
+		{
+			return (i - move) * 5 + j;
+		}
+		return BOARD_EATEN;
+	case 1:
+		if (i - move <= 4 && i - move >= 0 && j - move <= 4 && j - move >= 0)
+		{
+			return (i - move) * 5 + j - move;
+		}
+		return BOARD_EATEN;
+	case 2:
+		if (j - move <= 4 && j - move >= 0)
+		{
+			return i * 5 + j - move;
+		}
+		return BOARD_EATEN;
+	}
+	return BOARD_EATEN;
+}
+
+int Table_Target(int side, int seat, int way)
+{
+	return BOARD_MOVE.to[side][seat][way];
+}
+
+int main()
+{
+	//random (side,seat,way) so the compiler can't fold the lookups.
+	static int side[BENCH_INPUT], seat[BENCH_INPUT], way[BENCH_INPUT];
+	std::mt19937 gen(2019);
+	for (int k = 0; k < BENCH_INPUT; k++)
+	{
+		side[k] = gen() % 2;
+		seat[k] = gen() % 26;
+		way[k] = gen() % 3;
+		if (Switch_Target(side[k], seat[k], way[k]) != Table_Target(side[k], seat[k], way[k]))
+		{
+			std::cout << "table is different from switch at " << side[k] << " " << seat[k] << " " << way[k] << std::endl;
+			return 1;
+		}
+	}
+	long long sum[2] = { 0, 0 };
+	double time[2];
+	for (int version = 0; version < 2; version++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		for (int r = 0; r < BENCH_ROUND; r++)
+		{
+			for (int k = 0; k < BENCH_INPUT; k++)
+			{
+				if (version == 0)
+				{
+					sum[version] += Switch_Target(side[k], seat[k], way[k]);
+				}
+				else
+				{
+					sum[version] += Table_Target(side[k], seat[k], way[k]);
+				}
+			}
+		}
+		time[version] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	double count = double(BENCH_INPUT) * BENCH_ROUND;
+	std::cout << "switch: " << time[0] * 1e9 / count << " ns/move (sum " << sum[0] << ")" << std::endl;
+	std::cout << "table:  " << time[1] * 1e9 / count << " ns/move (sum " << sum[1] << ")" << std::endl;
+	std::cout << "speedup: " << time[0] / time[1] << "x" << std::endl;
+	return 0;
+}
@@ -0,0 +1,76 @@
+//benchmark:random playouts from the same start,one board at a time with Board_Successor()/Board_MakeMove()
+//like Simulation() plays,then Rollout with every board stepped one by one,then Rollout with AVX2.
+//the scalar and the AVX2 Rollout must give the same lt wins for the same seed,else it returns 1.
+//g++ -O2 -std=c++14 -mavx2 -I.. RolloutBench.cpp ../Rollout.cpp -o RolloutBench
+#include"Board.h"
+#include"Rollout.h"
+#include<chrono>
+#include<iostream>
+#include<random>
+#define BENCH_PLAYOUT 1000000
+#define BENCH_LANE 256
+#define BENCH_SEED 2019
+
+long long Bench_OneBoard(const state &start, int count)
+{
+	std::mt19937 gen(BENCH_SEED);
+	successor next;
+	undo back;
+	long long win = 0;
+	for (int p = 0; p < count; p++)
+	{
+		state s = start;
+		while (Board_Judge(s) == 0)
+		{
+			Board_Successor(s, gen() % 6 + 1, next);
+			Board_MakeMove(s, next.way[gen() % next.count], back);
+		}
+		if (Board_Judge(s) == LT_SIGN)
+		{
+			win++;
+		}
+	}
+	return win;
+}
+
+int main()
+{
+	const char *name[3] = { "one board:       ", "rollout scalar:  ", "rollout avx2:    " };
+	state start;
+	Board_AutoNumber(start.cb);
+	start.islt = true;
+	Board_Inital(start);
+	long long win[3] = { 0, 0, 0 };
+	double time[3];
+#ifdef __AVX2__
+	int versions = 3;
+#else
+	int versions = 2;
+	std::cout << "built without __AVX2__,the avx2 version is skipped" << std::endl;
+#endif
+	for (int version = 0; version < versions; version++)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		if (version == 0)
+		{
+			win[version] = Bench_OneBoard(start, BENCH_PLAYOUT);
+		}
+		else
+		{
+			Rollout rollout(BENCH_LANE, BENCH_SEED, version == 2);
+			win[version] = rollout.Play(start, BENCH_PLAYOUT);
+		}
+		time[version] = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		std::cout << name[version] << BENCH_PLAYOUT / time[version] << " playouts/s, lt win " << double(win[version]) / BENCH_PLAYOUT << std::endl;
+	}
+	if (versions == 3)
+	{
+		if (win[1] != win[2])
+		{
+			std::cout << "MISMATCH:scalar " << win[1] << " avx2 " << win[2] << std::endl;
+			return 1;
+		}
+		std::cout << "scalar and avx2 agree," << win[2] << " lt wins" << std::endl;
+	}
+	return 0;
+}
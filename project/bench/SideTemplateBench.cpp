@@ -0,0 +1,147 @@
+//benchmark:random playouts with the rules as they were before the side templates,which take the side from islt
+//in every call and use side == 0 ? ... for the goal,against Board_SuccessorSide/Board_MakeMoveSide where the side
+//is known when compiling.the i - move bounds of Game were already the BOARD_MOVE table before the templates.
+//g++ -O2 -std=c++14 -I.. SideTemplateBench.cpp ../Board.cpp -o SideTemplateBench
+#include"Board.h"
+#include<chrono>
+#include<cstdlib>
+#include<iostream>
+#include<random>
+#define BENCH_PLAYOUT 1000000
+
+//Board_MakeMove() before the side templates.
+bool Runtime_MakeMove(state &s, int W, undo &back)
+{
+	int side = s.islt ? 0 : 1;
+	int man = side * 6 + W / 3;
+	int f = s.seat[man];
+	int t = BOARD_MOVE.to[side][f][W % 3];
+	if (t == BOARD_EATEN)
+	{
+		return false;
+	}
+	back.man = char(man);
+	back.from = char(f);
+	back.to = char(t);
+	back.eaten = -1;
+	int eaten = s.cb.set[t / 5][t % 5];
+	if (eaten != 0)
+	{
+		int eaten_side = eaten < 0 ? 0 : 1;
+		int eaten_man = eaten_side * 6 + abs(eaten) - 1;
+		back.eaten = char(eaten_man);
+		s.seat[eaten_man] = BOARD_EATEN;
+		s.alive[eaten_side] &= ~(1 << (abs(eaten) - 1));
+		s.live[eaten_side]--;
+		s.key ^= BOARD_ZOBRIST.man[eaten_man][t];
+	}
+	s.seat[man] = char(t);
+	if (t == (side == 0 ? BOARD_GOAL_LT : BOARD_GOAL_RB))
+	{
+		s.goal = char(side == 0 ? LT_SIGN : RB_SIGN);
+	}
+	s.key ^= BOARD_ZOBRIST.man[man][f] ^ BOARD_ZOBRIST.man[man][t] ^ BOARD_ZOBRIST.lt;
+	s.cb.set[t / 5][t % 5] = s.cb.set[f / 5][f % 5];
+	s.cb.set[f / 5][f % 5] = 0;
+	s.islt = !s.islt;
+	return true;
+}
+
+//Board_Successor() before the side templates.
+void Runtime_Successor(const state &s, int dice, successor &next)
+{
+	int side = s.islt ? 0 : 1;
+	const dicemove &d = BOARD_DICE.at[s.alive[side]][dice - 1];
+	next.count = 0;
+	next.l = d.l;
+	next.r = d.r;
+	for (int k = 0; k < 2; k++)
+	{
+		if (d.man[k] == 0)
+		{
+			continue;
+		}
+		int f = s.seat[side * 6 + d.man[k] - 1];
+		for (int way = 0; way < 3; way++)
+		{
+			if (BOARD_MOVE.to[side][f][way] != BOARD_EATEN)
+			{
+				next.way[next.count] = char((d.man[k] - 1) * 3 + way);
+				next.slot[next.count] = char(way + k * 3);
+				next.count++;
+			}
+		}
+	}
+}
+
+int Bench_Runtime(state &s, std::mt19937 &gen)
+{
+	successor next;
+	undo back;
+	while (Board_Judge(s) == 0)
+	{
+		Runtime_Successor(s, gen() % 6 + 1, next);
+		Runtime_MakeMove(s, next.way[gen() % next.count], back);
+	}
+	return Board_Judge(s);
+}
+
+//one ply of SIDE,then the other side,only the first call looks at islt.
+template<int SIDE>
+int Bench_Side(state &s, std::mt19937 &gen)
+{
+	successor next;
+	undo back;
+	for (;;)
+	{
+		Board_SuccessorSide<SIDE>(s, gen() % 6 + 1, next);
+		Board_MakeMoveSide<SIDE>(s, next.way[gen() % next.count], back);
+		if (Board_Judge(s) != 0)
+		{
+			return Board_Judge(s);
+		}
+		Board_SuccessorSide<1 - SIDE>(s, gen() % 6 + 1, next);
+		Board_MakeMoveSide<1 - SIDE>(s, next.way[gen() % next.count], back);
+		if (Board_Judge(s) != 0)
+		{
+			return Board_Judge(s);
+		}
+	}
+}
+
+int main()
+{
+	const char *name[2] = { "side at run time: ", "side template:    " };
+	state start;
+	Board_AutoNumber(start.cb);
+	start.islt = true;
+	Board_Inital(start);
+	double time[2];
+	for (int version = 0; version < 2; version++)
+	{
+		std::mt19937 gen(2019);
+		long long win = 0;
+		auto begin = std::chrono::steady_clock::now();
+		for (int p = 0; p < BENCH_PLAYOUT; p++)
+		{
+			state s = start;
+			int result;
+			if (version == 0)
+			{
+				result = Bench_Runtime(s, gen);
+			}
+			else
+			{
+				result = s.islt ? Bench_Side<0>(s, gen) : Bench_Side<1>(s, gen);
+			}
+			if (result == LT_SIGN)
+			{
+				win++;
+			}
+		}
+		time[version] = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		std::cout << name[version] << time[version] * 1e9 / BENCH_PLAYOUT << " ns/playout (lt win " << win << ")" << std::endl;
+	}
+	std::cout << "speedup: " << time[0] / time[1] << "x" << std::endl;
+	return 0;
+}
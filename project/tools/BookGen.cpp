@@ -0,0 +1,81 @@
+//build the opening book for Game,put the file next to the program as book.bin.
+//g++ -O2 -std=c++14 -pthread -I.. BookGen.cpp ../Book.cpp ../Expectimax.cpp ../Evaluate.cpp ../Setup.cpp ../Tablebase.cpp ../MappedFile.cpp ../Board.cpp -o BookGen
+//usage:BookGen [ms for every search,default 100] [threads,default all cores] [plies,default 2] [file,default book.bin]
+//ai(lt) uses the setup Game would use,setup.bin when it is here,rb takes all 720 setups.
+//plies 1 only has the first move when ai is first-hand,plies 2 also has the answer to every first move of rb.
+//tablebase.bin is used by the searches when it is here.
+#include"Book.h"
+#include"Setup.h"
+#include<chrono>
+#include<cstdlib>
+#include<iostream>
+#include<thread>
+
+int main(int argc, char *argv[])
+{
+	int time = argc > 1 ? atoi(argv[1]) : 100;
+	int thread_count = argc > 2 ? atoi(argv[2]) : int(std::thread::hardware_concurrency());
+	int plies = argc > 3 ? atoi(argv[3]) : 2;
+	const char *path = argc > 4 ? argv[4] : BOOK_FILE;
+	Setup setup;
+	Tablebase table;
+	if (setup.Open(SETUP_FILE))
+	{
+		std::cout << "lt uses the best setup of " << SETUP_FILE << std::endl;
+	}
+	if (table.Open(TABLEBASE_FILE))
+	{
+		std::cout << "searches use " << TABLEBASE_FILE << std::endl;
+	}
+	chessboard start;
+	Board_AutoNumber(start);
+	setup.Place(start, 0);
+	vector<state> position;
+	successor next;
+	undo back;
+	for (int p = 0; p < SETUP_COUNT; p++)
+	{
+		state s;
+		s.cb = start;
+		Setup_Place(s.cb, 1, p);
+		s.islt = true;
+		Board_Inital(s);
+		position.push_back(s);
+		if (plies < 2)
+		{
+			continue;
+		}
+		s.islt = false;
+		Board_Inital(s);
+		for (int dice = 1; dice <= 6; dice++)
+		{
+			Board_Successor(s, dice, next);
+			for (int k = 0; k < next.count; k++)
+			{
+				Board_MakeMove(s, next.way[k], back);
+				position.push_back(s);
+				Board_UnmakeMove(s, back);
+			}
+		}
+	}
+	std::cout << position.size() << " states," << position.size() * 6 << " searches of " << time << " ms" << std::endl;
+	Book book;
+	auto begin = std::chrono::steady_clock::now();
+	book.Build(position, table.Pieces() > 0 ? &table : NULL, time, thread_count);
+	double second = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	std::cout << "built " << book.Count() << " entries with " << thread_count << " threads in " << second << " s" << std::endl;
+	if (!book.Save(path))
+	{
+		std::cout << "can't write " << path << std::endl;
+		return 1;
+	}
+	//read it back the way Game does.
+	Book check;
+	if (!check.Open(path) || check.Count() != book.Count())
+	{
+		std::cout << "can't map " << path << std::endl;
+		return 1;
+	}
+	std::cout << "saved " << path << std::endl;
+	return 0;
+}
@@ -0,0 +1,389 @@
+//perft:count every (dice,move) sequence to a depth,to check the rules core and to get its speed.
+//every depth is also counted by a copy of the old Game code(scan chessboard for the chessman,switch (W % 3),
+//search outward from dice with I_CanMove),the counts must be the same.
+//g++ -O2 -std=c++14 -I.. Perft.cpp ../Board.cpp -o Perft
+//usage:Perft depth [packed state in hex,from Board_Pack()] [-noref] [-size 4 to 8] [-pieces 1 to 6] [-canonical]
+//without packed state it starts from Board_AutoNumber() and lt moves first.
+//-size and -pieces count a variant with the same templates,a packed state is only for the game.
+//more than 6 chessman don't fit the corners of a 4x4 chessboard,so -pieces stops at 6.
+//-canonical also counts Board_Canonical() of the game state,and the chance of lt winning to the depth
+//(0.5 when it isn't over) of both,relabeling and mirror must not change them.
+#include"Board.h"
+#include<chrono>
+#include<cstdlib>
+#include<cstring>
+#include<iostream>
+
+//the old code with 5 changed to SIZE and 6 to PIECES.
+template<int SIZE>
+struct refstate
+{
+	basicchessboard<SIZE> cb;
+	bool islt;
+};
+
+template<int SIZE>
+bool Ref_CanMove(const refstate<SIZE> &s, int W)
+{
+	int move = s.islt ? LT_SIGN : RB_SIGN;
+	for (int i = 0; i < SIZE; i++)
+	{
+		for (int j = 0; j < SIZE; j++)
+		{
+			if (s.cb.set[i][j] == (W / 3 + 1)*move)
+			{
+				switch (W % 3)
+				{
+				case 0:
+					return i - move <= SIZE - 1 && i - move >= 0;
+				case 1:
+					return i - move <= SIZE - 1 && i - move >= 0 && j - move <= SIZE - 1 && j - move >= 0;
+				case 2:
+					return j - move <= SIZE - 1 && j - move >= 0;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+template<int SIZE>
+void Ref_MoveChessman(refstate<SIZE> &s, int W)
+{
+	int move = s.islt ? LT_SIGN : RB_SIGN;
+	for (int i = 0; i < SIZE; i++)
+	{
+		for (int j = 0; j < SIZE; j++)
+		{
+			if (s.cb.set[i][j] == (W / 3 + 1)*move)
+			{
+				switch (W % 3)
+				{
+				case 0:
+					s.cb.set[i - move][j] = s.cb.set[i][j];
+					break;
+				case 1:
+					s.cb.set[i - move][j - move] = s.cb.set[i][j];
+					break;
+				case 2:
+					s.cb.set[i][j - move] = s.cb.set[i][j];
+					break;
+				}
+				s.cb.set[i][j] = 0;
+				s.islt = !s.islt;
+				return;
+			}
+		}
+	}
+}
+
+template<int SIZE>
+int Ref_Judge(const refstate<SIZE> &s)
+{
+	int lt = 0;
+	int rb = 0;
+	if (s.cb.set[0][0] > 0)
+	{
+		return RB_SIGN;
+	}
+	if (s.cb.set[SIZE - 1][SIZE - 1] < 0)
+	{
+		return LT_SIGN;
+	}
+	for (int i = 0; i < SIZE; i++)
+	{
+		for (int j = 0; j < SIZE; j++)
+		{
+			if (s.cb.set[i][j] < 0)
+			{
+				lt++;
+			}
+			else if (s.cb.set[i][j] > 0)
+			{
+				rb++;
+			}
+		}
+	}
+	if (lt == 0)
+	{
+		return RB_SIGN;
+	}
+	if (rb == 0)
+	{
+		return LT_SIGN;
+	}
+	return 0;
+}
+
+template<int SIZE, int PIECES>
+long long Ref_Perft(const refstate<SIZE> &s, int depth)
+{
+	if (depth == 0 || Ref_Judge(s) != 0)
+	{
+		return 1;
+	}
+	long long count = 0;
+	for (int dice = 1; dice <= PIECES; dice++)
+	{
+		//the search of Game::Expansion(),a way is only counted once.
+		bool counted[PIECES * 3] = {};
+		int start, end;
+		bool finded_l = false;
+		bool finded_r = false;
+		for (int t = 0; !(finded_l && finded_r); t++)
+		{
+			if (!finded_l)
+			{
+				start = (dice - 1 - t) * 3;
+			}
+			if (!finded_r)
+			{
+				end = (dice + t) * 3;
+			}
+			if (start < 0)
+			{
+				start = 0;
+				finded_l = true;
+			}
+			if (end > PIECES * 3)
+			{
+				end = PIECES * 3;
+				finded_r = true;
+			}
+			for (int j = start; j < end; j++)
+			{
+				if (Ref_CanMove(s, j))
+				{
+					if (t == 0)
+					{
+						finded_l = true;
+						finded_r = true;
+					}
+					else
+					{
+						if (j < start + 3)
+						{
+							finded_l = true;
+						}
+						if (j >= end - 3)
+						{
+							finded_r = true;
+						}
+					}
+					if (!counted[j])
+					{
+						counted[j] = true;
+						refstate<SIZE> next = s;
+						Ref_MoveChessman(next, j);
+						count += Ref_Perft<SIZE, PIECES>(next, depth - 1);
+					}
+				}
+			}
+		}
+	}
+	return count;
+}
+
+//SIDE moves now,the next depth is the other side,so only the root chooses the side at run time.
+template<int SIDE, int SIZE, int PIECES>
+long long Perft(basicstate<SIZE, PIECES> &s, int depth)
+{
+	if (depth == 0 || Board_Judge(s) != 0)
+	{
+		return 1;
+	}
+	long long count = 0;
+	successor next;
+	undo back;
+	for (int dice = 1; dice <= PIECES; dice++)
+	{
+		Board_SuccessorSide<SIDE>(s, dice, next);
+		for (int k = 0; k < next.count; k++)
+		{
+			Board_MakeMoveSide<SIDE>(s, next.way[k], back);
+			count += Perft<1 - SIDE>(s, depth - 1);
+			Board_UnmakeMoveSide<SIDE>(s, back);
+		}
+	}
+	return count;
+}
+
+template<int SIZE, int PIECES>
+int Run(basicstate<SIZE, PIECES> &s, int depth, bool use_ref)
+{
+	refstate<SIZE> r;
+	r.cb = s.cb;
+	r.islt = s.islt;
+	bool same = true;
+	std::cout << SIZE << "x" << SIZE << " chessboard," << PIECES << " chessman" << std::endl;
+	for (int d = 1; d <= depth; d++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		long long count = s.islt ? Perft<0>(s, d) : Perft<1>(s, d);
+		double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "depth " << d << ": " << count << " leaves, " << time << " s, " << count / (time > 0 ? time : 1e-9) << " leaves/s";
+		if (use_ref)
+		{
+			start = std::chrono::steady_clock::now();
+			long long ref_count = Ref_Perft<SIZE, PIECES>(r, d);
+			double ref_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::cout << ", reference " << ref_count << " in " << ref_time << " s";
+			if (ref_count != count)
+			{
+				std::cout << " MISMATCH";
+				same = false;
+			}
+		}
+		std::cout << std::endl;
+	}
+	return same ? 0 : 1;
+}
+
+//expectimax without cut,the leaves are only won,lost or 0.5.
+double Value(state &s, int depth)
+{
+	int result = Board_Judge(s);
+	if (result != 0 || depth == 0)
+	{
+		return result == 0 ? 0.5 : (result == LT_SIGN ? 1.0 : 0.0);
+	}
+	double sum = 0;
+	successor next;
+	undo back;
+	for (int dice = 1; dice <= 6; dice++)
+	{
+		Board_Successor(s, dice, next);
+		double best = s.islt ? 0 : 1;
+		for (int k = 0; k < next.count; k++)
+		{
+			Board_MakeMove(s, next.way[k], back);
+			double value = Value(s, depth - 1);
+			Board_UnmakeMove(s, back);
+			best = s.islt ? (value > best ? value : best) : (value < best ? value : best);
+		}
+		sum += best;
+	}
+	return sum / 6;
+}
+
+int Canonical(state &s, int depth)
+{
+	bool mirrored;
+	state c;
+	Board_Unpack(Board_Canonical(s, mirrored), c);
+	bool same = true;
+	std::cout << std::hex << Board_Pack(s) << " canonical " << Board_Pack(c) << std::dec << (mirrored ? " mirrored" : "") << std::endl;
+	for (int d = 1; d <= depth; d++)
+	{
+		long long count = s.islt ? Perft<0>(s, d) : Perft<1>(s, d);
+		long long c_count = c.islt ? Perft<0>(c, d) : Perft<1>(c, d);
+		double value = Value(s, d);
+		double c_value = Value(c, d);
+		std::cout << "depth " << d << ": " << count << " and " << c_count << " leaves, lt wins " << value << " and " << c_value;
+		//the sums go in another order,so the values may differ in the last bits.
+		if (count != c_count || value - c_value > 1e-9 || c_value - value > 1e-9)
+		{
+			std::cout << " MISMATCH";
+			same = false;
+		}
+		std::cout << std::endl;
+	}
+	return same ? 0 : 1;
+}
+
+template<int SIZE, int PIECES>
+int Variant(int depth, bool use_ref)
+{
+	basicstate<SIZE, PIECES> s;
+	Board_AutoNumber<SIZE, PIECES>(s.cb);
+	s.islt = true;
+	Board_Inital(s);
+	return Run(s, depth, use_ref);
+}
+
+template<int SIZE>
+int Variant(int pieces, int depth, bool use_ref)
+{
+	switch (pieces)
+	{
+	case 1:
+		return Variant<SIZE, 1>(depth, use_ref);
+	case 2:
+		return Variant<SIZE, 2>(depth, use_ref);
+	case 3:
+		return Variant<SIZE, 3>(depth, use_ref);
+	case 4:
+		return Variant<SIZE, 4>(depth, use_ref);
+	case 5:
+		return Variant<SIZE, 5>(depth, use_ref);
+	case 6:
+		return Variant<SIZE, 6>(depth, use_ref);
+	}
+	std::cout << "pieces must be 1 to 6" << std::endl;
+	return 1;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		std::cout << "usage:Perft depth [packed state in hex] [-noref] [-size 4 to 8] [-pieces 1 to 6] [-canonical]" << std::endl;
+		return 1;
+	}
+	int depth = atoi(argv[1]);
+	bool use_ref = true;
+	bool canonical = false;
+	int size = BOARD_SIZE;
+	int pieces = BOARD_PIECES;
+	state s;
+	Board_AutoNumber(s.cb);
+	s.islt = true;
+	Board_Inital(s);
+	for (int k = 2; k < argc; k++)
+	{
+		if (strcmp(argv[k], "-noref") == 0)
+		{
+			use_ref = false;
+		}
+		else if (strcmp(argv[k], "-canonical") == 0)
+		{
+			canonical = true;
+		}
+		else if (strcmp(argv[k], "-size") == 0 && k + 1 < argc)
+		{
+			size = atoi(argv[++k]);
+		}
+		else if (strcmp(argv[k], "-pieces") == 0 && k + 1 < argc)
+		{
+			pieces = atoi(argv[++k]);
+		}
+		else if (!Board_Unpack(strtoull(argv[k], NULL, 16), s))
+		{
+			std::cout << argv[k] << " is not a packed state" << std::endl;
+			return 1;
+		}
+	}
+	if (size == BOARD_SIZE && pieces == BOARD_PIECES)
+	{
+		if (canonical)
+		{
+			return Canonical(s, depth);
+		}
+		return Run(s, depth, use_ref);
+	}
+	switch (size)
+	{
+	case 4:
+		return Variant<4>(pieces, depth, use_ref);
+	case 5:
+		return Variant<5>(pieces, depth, use_ref);
+	case 6:
+		return Variant<6>(pieces, depth, use_ref);
+	case 7:
+		return Variant<7>(pieces, depth, use_ref);
+	case 8:
+		return Variant<8>(pieces, depth, use_ref);
+	}
+	std::cout << "size must be 4 to 8" << std::endl;
+	return 1;
+}
@@ -0,0 +1,52 @@
+//rank the 720 setups for Game,put the file next to the program as setup.bin.
+//g++ -O2 -std=c++14 -pthread -I.. SetupGen.cpp ../Setup.cpp ../Evaluate.cpp ../MappedFile.cpp ../Board.cpp -o SetupGen
+//usage:SetupGen [games for every setup,default 20000] [threads,default all cores] [file,default setup.bin]
+#include"Setup.h"
+#include<chrono>
+#include<cstdlib>
+#include<iostream>
+#include<thread>
+
+int main(int argc, char *argv[])
+{
+	int games = argc > 1 ? atoi(argv[1]) : 20000;
+	int thread_count = argc > 2 ? atoi(argv[2]) : int(std::thread::hardware_concurrency());
+	const char *path = argc > 3 ? argv[3] : SETUP_FILE;
+	if (games < 2)
+	{
+		std::cout << "games must be 2 or more" << std::endl;
+		return 1;
+	}
+	Setup setup;
+	auto start = std::chrono::steady_clock::now();
+	setup.Build(games, thread_count);
+	double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "played " << games << " games for every setup with " << thread_count << " threads in " << time << " s" << std::endl;
+	if (!setup.Save(path))
+	{
+		std::cout << "can't write " << path << std::endl;
+		return 1;
+	}
+	//read it back the way Game does.
+	Setup check;
+	if (!check.Open(path))
+	{
+		std::cout << "can't map " << path << std::endl;
+		return 1;
+	}
+	const int show[] = { 0, 1, 2, SETUP_COUNT / 2, SETUP_COUNT - 1 };
+	for (int k = 0; k < 5; k++)
+	{
+		char number[6];
+		const setupentry &e = check.Rank(show[k]);
+		Setup_Numbers(e.permutation, number);
+		std::cout << "rank " << show[k] << ":";
+		for (int n = 0; n < 6; n++)
+		{
+			std::cout << " " << int(number[n]);
+		}
+		std::cout << " wins " << e.win << std::endl;
+	}
+	std::cout << "saved " << path << std::endl;
+	return 0;
+}
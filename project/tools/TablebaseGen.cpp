@@ -0,0 +1,40 @@
+//build the endgame tablebase for Game,put the file next to the program as tablebase.bin.
+//g++ -O2 -std=c++14 -pthread -I.. TablebaseGen.cpp ../Tablebase.cpp ../MappedFile.cpp ../Board.cpp -o TablebaseGen
+//usage:TablebaseGen [pieces,2 to 4,default 3] [threads,default all cores] [file,default tablebase.bin]
+//4 pieces needs about 160M of memory and file.
+#include"Tablebase.h"
+#include<chrono>
+#include<cstdlib>
+#include<iostream>
+#include<thread>
+
+int main(int argc, char *argv[])
+{
+	int pieces = argc > 1 ? atoi(argv[1]) : 3;
+	int thread_count = argc > 2 ? atoi(argv[2]) : int(std::thread::hardware_concurrency());
+	const char *path = argc > 3 ? argv[3] : TABLEBASE_FILE;
+	if (pieces < 2 || pieces > TABLEBASE_MAX_PIECES)
+	{
+		std::cout << "pieces must be 2 to " << TABLEBASE_MAX_PIECES << std::endl;
+		return 1;
+	}
+	Tablebase table;
+	auto start = std::chrono::steady_clock::now();
+	table.Build(pieces, thread_count);
+	double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "built " << pieces << " pieces with " << thread_count << " threads in " << time << " s" << std::endl;
+	if (!table.Save(path))
+	{
+		std::cout << "can't write " << path << std::endl;
+		return 1;
+	}
+	//read it back the way Game does.
+	Tablebase check;
+	if (!check.Open(path))
+	{
+		std::cout << "can't map " << path << std::endl;
+		return 1;
+	}
+	std::cout << "saved " << path << std::endl;
+	return 0;
+}